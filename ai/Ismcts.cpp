@@ -0,0 +1,173 @@
+#include "Ismcts.hpp"
+#include "../include/Game.hpp"
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+bool sameDecision(const Decision& a, const Decision& b) {
+    if (a.kind != b.kind) return false;
+    return a.kind != Decision::Act
+        || (a.action.type == b.action.type && a.action.target == b.action.target);
+}
+
+int indexOf(const Decision* moves, int n, const Decision& d) {
+    for (int i = 0; i < n; ++i) {
+        if (sameDecision(moves[i], d)) return i;
+    }
+    return -1;
+}
+
+const Decision kNoDecision = {Decision::Act, {ActionType::Gather, GameState::kNoSeat}};
+
+} // namespace
+
+Ismcts::Ismcts(const MctsConfig& config)
+    : _config(config), _rng(config.seed), _iterations(0) {}
+
+SearchState Ismcts::determinize(const SearchState& truth, int observer,
+                                const ObservationLog::Belief* beliefs,
+                                std::mt19937_64& rng) {
+    SearchState s = truth;
+    GameState& g = s.game;
+    for (int i = 0; i < g.activeCount; ++i) {
+        int seat = g.order[i];
+        if (seat == observer) continue;
+        const ObservationLog::Belief& b = beliefs[seat];
+
+        // Role: uniform over the roles still possible
+        int candidates[static_cast<int>(RoleId::Custom)];
+        int count = 0;
+        for (int r = 0; r < static_cast<int>(RoleId::Custom); ++r) {
+            if (b.roleMask & (1u << r)) candidates[count++] = r;
+        }
+        if (count > 0) {
+            RoleId role = static_cast<RoleId>(
+                candidates[std::uniform_int_distribution<int>(0, count - 1)(rng)]);
+            g.roles[seat] = role;
+            g.abilities[seat] = GameState::abilitiesOf(role);
+        }
+
+        // Coins: uniform over the estimate's error bound
+        int lo = b.coins - b.slack;
+        if (lo < 0) lo = 0;
+        g.coins[seat] = std::uniform_int_distribution<int>(lo, b.coins + b.slack)(rng);
+    }
+    g.rehash();
+    return s;
+}
+
+//
+// Each iteration: sample a determinization, descend while every legal
+// decision already has a child, add one child for an untried decision,
+// roll out, and credit each node to the seat that chose it.
+//
+Decision Ismcts::search(const SearchState& truth, int observer, const ObservationLog& log) {
+    ObservationLog::Belief beliefs[GameState::kMaxPlayers];
+    log.beliefs(observer, beliefs);
+
+    _nodes.clear();
+    _nodes.push_back({kNoDecision, -1, -1, 0, 0, 0.0});
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const int maxIterations = (_config.iterations > 0 || _config.timeLimitMs > 0)
+                            ? _config.iterations : 1;
+    Decision moves[SearchState::kMaxDecisions];
+    double rewards[GameState::kMaxPlayers];
+
+    int it = 0;
+    for (;; ++it) {
+        if (maxIterations > 0 && it >= maxIterations) break;
+        if (_config.timeLimitMs > 0 && (it & 15) == 0
+            && std::chrono::duration<double, std::milli>(Clock::now() - start).count()
+                   >= _config.timeLimitMs) {
+            break;
+        }
+
+        SearchState s = determinize(truth, observer, beliefs, _rng);
+        int node = 0;
+        _path.clear();
+        _movers.clear();
+        _path.push_back(node);
+        _movers.push_back(GameState::kNoSeat);
+
+        while (!s.terminal()) {
+            int n = s.decisions(moves);
+            if (n == 0) break;
+            int mover = s.toMove();
+
+            // Children legal in this determinization: bump availability, score
+            bool tried[SearchState::kMaxDecisions] = {};
+            int best = -1;
+            double bestScore = -1e300;
+            for (int c = _nodes[node].firstChild; c >= 0; c = _nodes[c].nextSibling) {
+                Node& child = _nodes[c];
+                int i = indexOf(moves, n, child.move);
+                if (i < 0) continue;
+                tried[i] = true;
+                ++child.avail;
+                double score = child.visits == 0 ? 1e300
+                    : child.value / child.visits
+                      + _config.exploration * std::sqrt(std::log(static_cast<double>(child.avail))
+                                                        / child.visits);
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = c;
+                }
+            }
+
+            int untried = 0;
+            for (int i = 0; i < n; ++i) untried += !tried[i];
+            if (untried > 0) {
+                // Expansion: one new child for a random untried decision
+                int k = std::uniform_int_distribution<int>(0, untried - 1)(_rng);
+                int i = 0;
+                for (;; ++i) {
+                    if (!tried[i] && k-- == 0) break;
+                }
+                int child = static_cast<int>(_nodes.size());
+                _nodes.push_back({moves[i], -1, _nodes[node].firstChild, 0, 1, 0.0});
+                _nodes[node].firstChild = child;
+                s.play(moves[i]);
+                _path.push_back(child);
+                _movers.push_back(mover);
+                break;
+            }
+
+            node = best;
+            s.play(_nodes[node].move);
+            _path.push_back(node);
+            _movers.push_back(mover);
+        }
+
+        Mcts::rollout(s, _rng, _config.rolloutLimit, rewards);
+        for (std::size_t i = 0; i < _path.size(); ++i) {
+            Node& nd = _nodes[_path[i]];
+            ++nd.visits;
+            if (_movers[i] != GameState::kNoSeat) nd.value += rewards[_movers[i]];
+        }
+    }
+    _iterations = it;
+
+    int best = -1;
+    for (int c = _nodes[0].firstChild; c >= 0; c = _nodes[c].nextSibling) {
+        if (best < 0 || _nodes[c].visits > _nodes[best].visits) best = c;
+    }
+    return best < 0 ? kNoDecision : _nodes[best].move;
+}
+
+Action Ismcts::chooseAction(const Game& game) {
+    const GameState& g = game.state();
+    int observer = g.currentSeat();
+    if (const ObservationLog* log = game.observationLog()) {
+        return search(SearchState(g), observer, *log).action;
+    }
+    // No log: balances known, roles unknown
+    ObservationLog known;
+    for (int i = 0; i < g.activeCount; ++i) {
+        int seat = g.order[i];
+        known.recordJoin(seat, g.coins[seat]);
+    }
+    return search(SearchState(g), observer, known).action;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Mcts.hpp"
+#include "SearchState.hpp"
+#include "../include/ObservationLog.hpp"
+
+class Game;
+
+/**
+ * @brief Determinizing information-set MCTS (single observer tree).
+ *
+ * The searching seat only knows its own role and coins; for everyone else
+ * it has the beliefs an ObservationLog derives from public actions and its
+ * own Spy reveals. Each iteration samples a determinization, a full
+ * SearchState whose hidden roles and balances are drawn from those beliefs,
+ * and walks one shared tree restricted to the decisions legal in that
+ * sample. Statistics are shared by every determinization; selection uses
+ * availability counts (how often a child was legal when its parent was
+ * visited) in place of the parent's visit count.
+ *
+ * A determinization is a copy of the true SearchState (one memcpy) with the
+ * hidden fields overwritten, never a rebuild of Players and a Game.
+ */
+class Ismcts {
+public:
+    /**
+     * @brief One tree node. Children of a node are linked through nextSibling
+     * because different determinizations reveal different children.
+     */
+    struct Node {
+        Decision      move;         ///< Decision leading here from the parent.
+        std::int32_t  firstChild;   ///< Arena index of the first child, or -1.
+        std::int32_t  nextSibling;  ///< Arena index of the next sibling, or -1.
+        std::uint32_t visits;       ///< Iterations through this node.
+        std::uint32_t avail;        ///< Iterations in which move was legal at the parent.
+        double        value;        ///< Sum of the deciding seat's rewards.
+    };
+
+    explicit Ismcts(const MctsConfig& config = MctsConfig());
+
+    /**
+     * @brief Search for observer, who must be truth.toMove().
+     * @param truth    The real position; only observer's private data and
+     *                 public fields are read from it.
+     * @param observer The searching seat.
+     * @param log      What has been observed so far.
+     * @return The most visited decision at the root.
+     */
+    Decision search(const SearchState& truth, int observer, const ObservationLog& log);
+
+    /**
+     * @brief Choose the current player's action in a live Game, using its
+     * observation log. Without a log, balances are taken as known and
+     * opponents' roles as unknown.
+     */
+    Action chooseAction(const Game& game);
+
+    /**
+     * @brief Sample a position consistent with observer's beliefs.
+     * Other living seats get a role drawn from Belief::roleMask and a balance
+     * drawn from coins ± slack; observer's own seat and all public fields
+     * (turn order, pool, pending actions) are kept from truth.
+     * @param beliefs One Belief per seat, from ObservationLog::beliefs().
+     */
+    static SearchState determinize(const SearchState& truth, int observer,
+                                   const ObservationLog::Belief* beliefs,
+                                   std::mt19937_64& rng);
+
+    /// Iterations run by the last search.
+    int iterations() const { return _iterations; }
+
+    /// The tree of the last search; the root is at index 0.
+    const std::vector<Node>& nodes() const { return _nodes; }
+
+private:
+    MctsConfig        _config;
+    std::mt19937_64   _rng;
+    std::vector<Node> _nodes;
+    std::vector<int>  _path;     ///< Scratch: nodes visited by the current iteration.
+    std::vector<int>  _movers;   ///< Scratch: seat that chose each node on _path.
+    int               _iterations;
+};
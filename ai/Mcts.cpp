@@ -0,0 +1,132 @@
+#include "Mcts.hpp"
+#include "../include/Game.hpp"
+#include <chrono>
+#include <cmath>
+
+Mcts::Mcts(const MctsConfig& config)
+    : _config(config), _rng(config.seed), _iterations(0) {}
+
+//
+// Run iterations until a budget is spent, then pick the most visited
+// child of the root (the robust choice; its value is the least noisy).
+//
+Decision Mcts::search(const SearchState& root) {
+    _nodes.clear();
+    _nodes.push_back({{Decision::Act, {ActionType::Gather, GameState::kNoSeat}},
+                      -1, 0, GameState::kNoSeat, 0, 0.0});
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const int maxIterations = (_config.iterations > 0 || _config.timeLimitMs > 0)
+                            ? _config.iterations : 1;
+    double rewards[GameState::kMaxPlayers];
+
+    int it = 0;
+    for (;; ++it) {
+        if (maxIterations > 0 && it >= maxIterations) break;
+        if (_config.timeLimitMs > 0 && (it & 15) == 0
+            && std::chrono::duration<double, std::milli>(Clock::now() - start).count()
+                   >= _config.timeLimitMs) {
+            break;
+        }
+
+        // Selection
+        SearchState s = root;
+        int node = 0;
+        _path.clear();
+        _path.push_back(node);
+        while (_nodes[node].firstChild >= 0 && _nodes[node].childCount > 0) {
+            node = select(node);
+            s.play(_nodes[node].move);
+            _path.push_back(node);
+        }
+
+        // Expansion: add every child, then step into the first one
+        if (!s.terminal() && _nodes[node].firstChild < 0) {
+            expand(node, s);
+            if (_nodes[node].childCount > 0) {
+                node = _nodes[node].firstChild;
+                s.play(_nodes[node].move);
+                _path.push_back(node);
+            }
+        }
+
+        // Simulation and backpropagation
+        rollout(s, _rng, _config.rolloutLimit, rewards);
+        for (int n : _path) {
+            Node& nd = _nodes[n];
+            ++nd.visits;
+            if (nd.mover != GameState::kNoSeat) nd.value += rewards[nd.mover];
+        }
+    }
+    _iterations = it;
+
+    const Node& r = _nodes[0];
+    if (r.firstChild < 0 || r.childCount == 0) {
+        return {Decision::Act, {ActionType::Gather, GameState::kNoSeat}};
+    }
+    int best = r.firstChild;
+    for (int c = r.firstChild + 1; c < r.firstChild + r.childCount; ++c) {
+        if (_nodes[c].visits > _nodes[best].visits) best = c;
+    }
+    return _nodes[best].move;
+}
+
+Action Mcts::chooseAction(const Game& game) {
+    return search(SearchState(game.state())).action;
+}
+
+int Mcts::select(int node) {
+    const Node& parent = _nodes[node];
+    const double logN = std::log(static_cast<double>(parent.visits));
+    int best = parent.firstChild;
+    double bestScore = -1.0;
+    for (int c = parent.firstChild; c < parent.firstChild + parent.childCount; ++c) {
+        const Node& child = _nodes[c];
+        if (child.visits == 0) return c;
+        double score = child.value / child.visits
+                     + _config.exploration * std::sqrt(logN / child.visits);
+        if (score > bestScore) {
+            bestScore = score;
+            best = c;
+        }
+    }
+    return best;
+}
+
+void Mcts::expand(int node, const SearchState& s) {
+    Decision moves[SearchState::kMaxDecisions];
+    int n = s.decisions(moves);
+    std::int8_t mover = static_cast<std::int8_t>(s.toMove());
+    _nodes[node].firstChild = static_cast<std::int32_t>(_nodes.size());
+    _nodes[node].childCount = static_cast<std::uint16_t>(n);
+    for (int i = 0; i < n; ++i) {
+        _nodes.push_back({moves[i], -1, 0, mover, 0, 0.0});
+    }
+}
+
+//
+// Uniformly random decisions (blockers block half the time) until one seat
+// is left or the limit is hit, in which case survivors share the point.
+//
+void Mcts::rollout(SearchState& s, std::mt19937_64& rng, int limit, double* rewards) {
+    Decision moves[SearchState::kMaxDecisions];
+    for (int step = 0; !s.terminal() && step < limit; ++step) {
+        int n = s.decisions(moves);
+        if (n == 0) break;
+        s.play(moves[std::uniform_int_distribution<int>(0, n - 1)(rng)]);
+    }
+
+    for (int i = 0; i < GameState::kMaxPlayers; ++i) rewards[i] = 0.0;
+    const GameState& g = s.game;
+    for (int i = 0; i < g.activeCount; ++i) {
+        rewards[g.order[i]] = 1.0 / g.activeCount;
+    }
+}
+
+Action MctsAgent::choose(const GameState& state, int /*seat*/, std::mt19937_64& rng) const {
+    MctsConfig config = _config;
+    config.seed = rng();
+    Mcts mcts(config);
+    return mcts.search(SearchState(state)).action;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "SearchState.hpp"
+#include "../include/Agent.hpp"
+
+class Game;
+
+/**
+ * @brief Search budget and tuning for Mcts.
+ * The search stops at whichever budget runs out first; a zero budget is
+ * unlimited, and with both zero a single iteration is run.
+ */
+struct MctsConfig {
+    int           iterations   = 1000;  ///< Playouts per search.
+    double        timeLimitMs  = 0;     ///< Wall-clock budget per search, in milliseconds.
+    double        exploration  = 1.41;  ///< UCT exploration constant C.
+    int           rolloutLimit = 200;   ///< Decisions per rollout before it is scored as a draw.
+    std::uint64_t seed         = 1;     ///< Seed for rollouts and tie-breaking.
+};
+
+/**
+ * @brief Monte Carlo Tree Search over SearchState decisions.
+ *
+ * Each iteration descends the tree by UCT, expands one leaf (all of its
+ * children at once), finishes the match with uniformly random decisions and
+ * backs the result up: 1 to the winner, a share for each survivor if the
+ * rollout limit is hit. A node's value is from the point of view of the seat
+ * that made its decision, so the same tree serves every player and every
+ * blocker.
+ *
+ * Nodes live in one contiguous arena, and the children of a node occupy a
+ * contiguous range of it. The arena is reused across searches.
+ */
+class Mcts {
+public:
+    /**
+     * @brief One tree node.
+     */
+    struct Node {
+        Decision      move;        ///< Decision leading here from the parent.
+        std::int32_t  firstChild;  ///< Arena index of the first child, or -1 if unexpanded.
+        std::uint16_t childCount;  ///< Number of children.
+        std::int8_t   mover;       ///< Seat that made move (kNoSeat at the root).
+        std::uint32_t visits;      ///< Iterations through this node.
+        double        value;       ///< Sum of mover's rewards over those iterations.
+    };
+
+    explicit Mcts(const MctsConfig& config = MctsConfig());
+
+    /**
+     * @brief Search from root and return the most visited decision for root.toMove().
+     * root must not be terminal.
+     */
+    Decision search(const SearchState& root);
+
+    /**
+     * @brief Choose the current player's action in a live Game.
+     * Targets are seats (see Game::playerAt()).
+     */
+    Action chooseAction(const Game& game);
+
+    /// Iterations run by the last search.
+    int iterations() const { return _iterations; }
+
+    /// The tree of the last search; the root is at index 0.
+    const std::vector<Node>& nodes() const { return _nodes; }
+
+    /**
+     * @brief Play s out with uniformly random decisions (blockers block half
+     * the time) and write each seat's reward to rewards: 1 to the winner, or
+     * an equal share for each survivor if limit decisions were not enough.
+     */
+    static void rollout(SearchState& s, std::mt19937_64& rng, int limit, double* rewards);
+
+private:
+    MctsConfig        _config;
+    std::mt19937_64   _rng;
+    std::vector<Node> _nodes;       ///< Node arena.
+    std::vector<int>  _path;        ///< Scratch: nodes visited by the current iteration.
+    int               _iterations;
+
+    /// Child of node with the highest UCT score (unvisited children first).
+    int select(int node);
+
+    /// Append the children of node for the decisions available in s.
+    void expand(int node, const SearchState& s);
+};
+
+/**
+ * @brief Agent adapter so Mcts can play in the self-play simulator.
+ * Each choose() runs a fresh search seeded from the caller's generator.
+ */
+class MctsAgent : public Agent {
+public:
+    explicit MctsAgent(const MctsConfig& config = MctsConfig()) : _config(config) {}
+
+    Action choose(const GameState& state, int seat, std::mt19937_64& rng) const override;
+    const char* name() const override { return "mcts"; }
+
+private:
+    MctsConfig _config;
+};
@@ -0,0 +1,240 @@
+#include "ParallelMcts.hpp"
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// splitmix64: independent per-thread seeds from one configured seed.
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+const Decision kNoDecision = {Decision::Act, {ActionType::Gather, GameState::kNoSeat}};
+
+} // namespace
+
+ParallelMcts::ParallelMcts(const MctsConfig& config, const Options& options)
+    : _config(config), _options(options), _threads(options.threads),
+      _used(0), _started(0), _playouts(0), _stop(false), _budget(0) {
+    if (_threads <= 0) _threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (_threads <= 0) _threads = 1;
+    if (_options.mode == Mode::Tree) {
+        _nodes.reset(new Node[_options.maxNodes]);
+    }
+}
+
+ParallelMcts::~ParallelMcts() = default;
+
+Decision ParallelMcts::search(const SearchState& root) {
+    _started = 0;
+    _playouts = 0;
+    _stop = false;
+    _budget = (_config.iterations > 0 || _config.timeLimitMs > 0) ? _config.iterations : 1;
+    _start = std::chrono::steady_clock::now();
+    return _options.mode == Mode::Tree ? searchTree(root) : searchRoot(root);
+}
+
+//
+// Tree parallelism: one shared tree, lock-free statistics, virtual loss.
+//
+Decision ParallelMcts::searchTree(const SearchState& root) {
+    resetNode(_nodes[0], kNoDecision, GameState::kNoSeat);
+    _used = 1;
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < _threads; ++t) {
+        workers.emplace_back(&ParallelMcts::treeWorker, this, std::cref(root), mix(_config.seed + t));
+    }
+    treeWorker(root, mix(_config.seed));
+    for (std::thread& w : workers) w.join();
+
+    const Node& r = _nodes[0];
+    if (r.state.load() != Expanded || r.childCount == 0) {
+        return kNoDecision;
+    }
+    int best = r.firstChild;
+    for (int c = r.firstChild + 1; c < r.firstChild + r.childCount; ++c) {
+        if (_nodes[c].visits.load() > _nodes[best].visits.load()) best = c;
+    }
+    return _nodes[best].move;
+}
+
+void ParallelMcts::treeWorker(const SearchState& root, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<int> path;
+    double rewards[GameState::kMaxPlayers];
+    const int vl = _options.virtualLoss;
+
+    for (long it = 0; claim(it); ++it) {
+        // Selection, adding a virtual loss to every node on the way down
+        SearchState s = root;
+        int node = 0;
+        path.clear();
+        path.push_back(node);
+        _nodes[node].visits.fetch_add(vl, std::memory_order_relaxed);
+        while (_nodes[node].state.load(std::memory_order_acquire) == Expanded
+               && _nodes[node].childCount > 0) {
+            node = select(node);
+            _nodes[node].visits.fetch_add(vl, std::memory_order_relaxed);
+            s.play(_nodes[node].move);
+            path.push_back(node);
+        }
+
+        // Expansion: step into a random child so concurrent expanders diverge
+        if (!s.terminal() && expand(node, s) && _nodes[node].childCount > 0) {
+            const Node& n = _nodes[node];
+            node = n.firstChild + std::uniform_int_distribution<int>(0, n.childCount - 1)(rng);
+            _nodes[node].visits.fetch_add(vl, std::memory_order_relaxed);
+            s.play(_nodes[node].move);
+            path.push_back(node);
+        }
+
+        // Simulation, then replace each virtual loss with the real result
+        Mcts::rollout(s, rng, _config.rolloutLimit, rewards);
+        for (int i : path) {
+            Node& n = _nodes[i];
+            n.visits.fetch_add(1 - vl, std::memory_order_relaxed);
+            if (n.mover != GameState::kNoSeat) {
+                n.value.fetch_add(std::llround(rewards[n.mover] * kValueScale),
+                                  std::memory_order_relaxed);
+            }
+        }
+        _playouts.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool ParallelMcts::claim(long it) {
+    if (_stop.load(std::memory_order_relaxed)) return false;
+    if (_config.timeLimitMs > 0 && (it & 15) == 0) {
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - _start).count();
+        if (ms >= _config.timeLimitMs) {
+            _stop.store(true, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    return _budget <= 0 || _started.fetch_add(1, std::memory_order_relaxed) < _budget;
+}
+
+int ParallelMcts::select(int node) const {
+    const Node& parent = _nodes[node];
+    int pv = parent.visits.load(std::memory_order_relaxed);
+    const double logN = std::log(static_cast<double>(pv > 1 ? pv : 1));
+    int best = parent.firstChild;
+    double bestScore = -1e300;
+    for (int c = parent.firstChild; c < parent.firstChild + parent.childCount; ++c) {
+        const Node& child = _nodes[c];
+        int v = child.visits.load(std::memory_order_relaxed);
+        if (v <= 0) return c;
+        double q = static_cast<double>(child.value.load(std::memory_order_relaxed))
+                 / kValueScale / v;
+        double score = q + _config.exploration * std::sqrt(logN / v);
+        if (score > bestScore) {
+            bestScore = score;
+            best = c;
+        }
+    }
+    return best;
+}
+
+//
+// The thread that moves node from Leaf to Expanding owns it until it
+// publishes the children with a release store of Expanded.
+//
+bool ParallelMcts::expand(int node, const SearchState& s) {
+    Node& n = _nodes[node];
+    std::uint8_t expected = Leaf;
+    if (!n.state.compare_exchange_strong(expected, Expanding, std::memory_order_acquire)) {
+        return false;
+    }
+    Decision moves[SearchState::kMaxDecisions];
+    int count = s.decisions(moves);
+    std::size_t base = _used.load(std::memory_order_relaxed);
+    do {
+        if (base + count > _options.maxNodes) {
+            n.state.store(Leaf, std::memory_order_release);
+            return false;
+        }
+    } while (!_used.compare_exchange_weak(base, base + count, std::memory_order_relaxed));
+
+    int mover = s.toMove();
+    for (int i = 0; i < count; ++i) {
+        resetNode(_nodes[base + i], moves[i], mover);
+    }
+    n.firstChild = static_cast<std::int32_t>(base);
+    n.childCount = static_cast<std::uint16_t>(count);
+    n.state.store(Expanded, std::memory_order_release);
+    return true;
+}
+
+void ParallelMcts::resetNode(Node& n, const Decision& move, int mover) {
+    n.move = move;
+    n.firstChild = -1;
+    n.childCount = 0;
+    n.mover = static_cast<std::int8_t>(mover);
+    n.state.store(Leaf, std::memory_order_relaxed);
+    n.visits.store(0, std::memory_order_relaxed);
+    n.value.store(0, std::memory_order_relaxed);
+}
+
+//
+// Root parallelism: private trees, merged at the root. Every tree expands
+// the root from the same position, so child i is the same decision in each.
+//
+Decision ParallelMcts::searchRoot(const SearchState& root) {
+    int threads = _threads;
+    if (_budget > 0 && _budget < threads) threads = static_cast<int>(_budget);
+
+    std::vector<std::vector<double>> visits(threads), values(threads);
+    std::vector<Decision> moves;
+    std::vector<std::thread> workers;
+    auto work = [&](int t) {
+        MctsConfig c = _config;
+        c.seed = mix(_config.seed + t);
+        if (_budget > 0) c.iterations = static_cast<int>(_budget / threads + (t < _budget % threads));
+        Mcts mcts(c);
+        mcts.search(root);
+        const std::vector<Mcts::Node>& nodes = mcts.nodes();
+        const Mcts::Node& r = nodes[0];
+        for (int i = 0; r.firstChild >= 0 && i < r.childCount; ++i) {
+            visits[t].push_back(nodes[r.firstChild + i].visits);
+            values[t].push_back(nodes[r.firstChild + i].value);
+        }
+        if (t == 0) {
+            for (int i = 0; r.firstChild >= 0 && i < r.childCount; ++i) {
+                moves.push_back(nodes[r.firstChild + i].move);
+            }
+        }
+        _playouts.fetch_add(mcts.iterations(), std::memory_order_relaxed);
+    };
+    for (int t = 1; t < threads; ++t) workers.emplace_back(work, t);
+    work(0);
+    for (std::thread& w : workers) w.join();
+
+    // Pooled over the trees, the most visited child wins; between children
+    // with as many visits, the higher total (so mean) reward.
+    int best = -1;
+    double bestVisits = -1;
+    double bestValue = 0;
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        double n = 0;
+        double v = 0;
+        for (int t = 0; t < threads; ++t) {
+            if (i < visits[t].size()) {
+                n += visits[t][i];
+                v += values[t][i];
+            }
+        }
+        if (n > bestVisits || (n == bestVisits && v > bestValue)) {
+            bestVisits = n;
+            bestValue = v;
+            best = static_cast<int>(i);
+        }
+    }
+    return best < 0 ? kNoDecision : moves[best];
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Mcts.hpp"
+#include "SearchState.hpp"
+
+/**
+ * @brief Multithreaded MCTS over SearchState decisions.
+ *
+ * Two modes:
+ *  - Tree: all threads search one shared tree. Node statistics are atomic
+ *    counters in a flat, preallocated node pool, and a thread descending
+ *    through a node adds a virtual loss (extra visits with no reward) so
+ *    concurrent threads spread over different lines. No locks are taken;
+ *    a node is expanded by whichever thread wins a compare-and-swap on it.
+ *  - Root: each thread grows a private Mcts tree from its own seed, and
+ *    the root children's visits and values are summed at the end.
+ *
+ * The iteration budget (MctsConfig::iterations) is shared by all threads;
+ * the time budget applies to the search as a whole.
+ */
+class ParallelMcts {
+public:
+    enum class Mode { Tree, Root };
+
+    /**
+     * @brief Threading options.
+     */
+    struct Options {
+        int         threads     = 0;          ///< Worker threads (0 → hardware concurrency).
+        Mode        mode        = Mode::Tree; ///< Shared tree or per-thread trees.
+        int         virtualLoss = 3;          ///< Visits added per in-flight descent (Tree mode).
+        std::size_t maxNodes    = 1 << 20;    ///< Node pool capacity (Tree mode).
+    };
+
+    /**
+     * @brief One shared-tree node. visits includes in-flight virtual losses;
+     * value is the mover's reward sum in units of 1 / kValueScale.
+     */
+    struct Node {
+        Decision                   move;        ///< Decision leading here from the parent.
+        std::int32_t               firstChild;  ///< Pool index of the first child (valid once Expanded).
+        std::uint16_t              childCount;  ///< Number of children (valid once Expanded).
+        std::int8_t                mover;       ///< Seat that made move (kNoSeat at the root).
+        std::atomic<std::uint8_t>  state;       ///< Leaf, Expanding or Expanded.
+        std::atomic<std::int32_t>  visits;
+        std::atomic<std::int64_t>  value;
+    };
+
+    static constexpr std::int64_t kValueScale = 1 << 20;  ///< Fixed-point scale of Node::value.
+
+    ParallelMcts(const MctsConfig& config, const Options& options);
+    ~ParallelMcts();
+
+    ParallelMcts(const ParallelMcts&) = delete;
+    ParallelMcts& operator=(const ParallelMcts&) = delete;
+
+    /**
+     * @brief Search from root with all threads and return the most visited
+     * decision for root.toMove(). root must not be terminal.
+     */
+    Decision search(const SearchState& root);
+
+    /// Playouts completed by the last search, over all threads.
+    long playouts() const { return _playouts.load(); }
+
+    /// Nodes used in the shared pool by the last search (Tree mode).
+    std::size_t nodeCount() const { return _used.load(); }
+
+    /// Number of worker threads.
+    int threads() const { return _threads; }
+
+private:
+    enum : std::uint8_t { Leaf, Expanding, Expanded };
+
+    MctsConfig              _config;
+    Options                 _options;
+    int                     _threads;
+    std::unique_ptr<Node[]> _nodes;      ///< Shared node pool (Tree mode).
+    std::atomic<std::size_t> _used;      ///< Nodes handed out from the pool.
+    std::atomic<long>       _started;    ///< Iterations claimed against the budget.
+    std::atomic<long>       _playouts;   ///< Iterations finished.
+    std::atomic<bool>       _stop;       ///< Set once the time budget is spent.
+    long                    _budget;     ///< Iteration budget of the current search (0 = none).
+    std::chrono::steady_clock::time_point _start;  ///< Start of the current search.
+
+    Decision searchTree(const SearchState& root);
+    Decision searchRoot(const SearchState& root);
+
+    /// One thread's share of a Tree-mode search.
+    void treeWorker(const SearchState& root, std::uint64_t seed);
+
+    /// Claim the next iteration; false once a budget is spent. Every 16th
+    /// call of a thread (it & 15 == 0) also checks the clock.
+    bool claim(long it);
+
+    /// Child of node with the highest UCT score, counting virtual losses.
+    int select(int node) const;
+
+    /// Try to expand node for s; false if another thread holds it or the pool is full.
+    bool expand(int node, const SearchState& s);
+
+    void resetNode(Node& n, const Decision& move, int mover);
+};
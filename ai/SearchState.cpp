@@ -0,0 +1,115 @@
+#include "SearchState.hpp"
+#include "../include/ActionBuffer.hpp"
+
+namespace {
+
+// Actions that some role can block, and therefore open a window.
+bool blockable(ActionType type) {
+    return type == ActionType::Tax || type == ActionType::Bribe
+        || type == ActionType::Arrest || type == ActionType::Coup;
+}
+
+} // namespace
+
+SearchState::SearchState(const GameState& g)
+    : game(g), declared{ActionType::Gather, GameState::kNoSeat},
+      actor(GameState::kNoSeat), scan(0) {}
+
+SearchState SearchState::window(const GameState& g, int actor, const Action& declared) {
+    SearchState s(g);
+    s.declared = declared;
+    s.actor = static_cast<std::int8_t>(actor);
+    s.advance();
+    return s;
+}
+
+int SearchState::toMove() const {
+    if (terminal()) return GameState::kNoSeat;
+    if (!inWindow()) return game.currentSeat();
+    return game.order[(game.currentIndex + scan) % game.activeCount];
+}
+
+bool SearchState::mayBlock(int seat) const {
+    if (seat == actor || !game.isAlive(seat)
+        || !GameState::canBlock(game.roles[seat], declared.type)) {
+        return false;
+    }
+    switch (declared.type) {
+        case ActionType::Tax:
+        case ActionType::Bribe:
+            return game.findPending(declared.type, actor) >= 0;
+        case ActionType::Arrest:
+            return game.findPending(declared.type, declared.target) >= 0;
+        case ActionType::Coup:
+            return game.coins[seat] >= 5 && game.findPending(declared.type, declared.target) >= 0;
+        default:
+            return false;
+    }
+}
+
+int SearchState::decisions(Decision* out) const {
+    if (terminal()) return 0;
+    if (inWindow()) {
+        out[0] = {Decision::Pass, declared};
+        out[1] = {Decision::Block, declared};
+        return 2;
+    }
+    ActionBuffer moves;
+    game.legalActions(game.currentSeat(), moves);
+    int n = 0;
+    for (const Action& a : moves) {
+        out[n++] = {Decision::Act, a};
+    }
+    return n;
+}
+
+bool SearchState::play(const Decision& d) {
+    if (terminal()) return false;
+
+    if (!inWindow()) {
+        if (d.kind != Decision::Act) return false;
+        int seat = game.currentSeat();
+        if (game.declare(seat, d.action) != ActionResult::Ok) return false;
+        declared = d.action;
+        actor = static_cast<std::int8_t>(seat);
+        if (blockable(d.action.type)) {
+            scan = 0;
+            advance();
+        } else {
+            close();
+        }
+        return true;
+    }
+
+    if (d.kind == Decision::Pass) {
+        advance();
+        return true;
+    }
+    if (d.kind != Decision::Block) return false;
+    ActionResult r = ActionResult::NotAllowed;
+    switch (declared.type) {
+        case ActionType::Tax:    r = game.blockTax(actor); break;
+        case ActionType::Bribe:  r = game.blockBribe(actor); break;
+        case ActionType::Arrest: r = game.blockArrest(declared.target); break;
+        case ActionType::Coup:   r = game.blockCoup(toMove(), declared.target); break;
+        default: break;
+    }
+    if (r != ActionResult::Ok) return false;
+    close();
+    return true;
+}
+
+void SearchState::advance() {
+    for (++scan; scan < game.activeCount; ++scan) {
+        if (mayBlock(game.order[(game.currentIndex + scan) % game.activeCount])) return;
+    }
+    close();
+}
+
+void SearchState::close() {
+    actor = GameState::kNoSeat;
+    scan = 0;
+    if (declared.type != ActionType::Bribe) {
+        game.nextTurn();
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "../include/Action.hpp"
+#include "../include/GameState.hpp"
+
+/**
+ * @brief One choice in a search tree: a player's action, or a blocker's
+ * answer to the action waiting in a block window.
+ */
+struct Decision {
+    enum Kind : std::uint8_t {
+        Act,    ///< Play action (current player).
+        Pass,   ///< Let the declared action stand.
+        Block   ///< Block the declared action.
+    };
+
+    Kind   kind;
+    Action action;  ///< The action for Act; unused otherwise.
+};
+
+/**
+ * @brief GameState plus the block window that follows a declared action.
+ *
+ * The engine resolves actions at the next nextTurn(). Between declaration and
+ * resolution, every living seat whose role can block the action (Governor:
+ * Tax, Judge: Bribe, Spy: Arrest, General: Coup with 5 coins to pay) is asked
+ * in turn order, starting after the actor, whether to Block or Pass. The first
+ * Block closes the window; so does the last Pass. Closing the window ends the
+ * turn, except after a Bribe, whose actor moves again.
+ *
+ * Trivially copyable like GameState, so a search node's position is a memcpy.
+ */
+struct SearchState {
+    static constexpr int kMaxDecisions = 3 + 3 * GameState::kMaxPlayers;
+
+    GameState   game;      ///< The position.
+    Action      declared;  ///< Action waiting in the block window.
+    std::int8_t actor;     ///< Seat that declared it, or kNoSeat outside a window.
+    std::int8_t scan;      ///< Offset in game.order[] from the actor to the blocker asked now.
+
+    /**
+     * @brief A position outside any block window.
+     */
+    explicit SearchState(const GameState& g);
+
+    /**
+     * @brief A position inside the block window of an action that actor has
+     * already declared (see GameState::declare()); the first eligible blocker
+     * moves next. With no eligible blocker the window closes immediately.
+     */
+    static SearchState window(const GameState& g, int actor, const Action& declared);
+
+    /// True while blockers are being asked about declared.
+    bool inWindow() const { return actor != GameState::kNoSeat; }
+
+    /// True once one player (or none) is left.
+    bool terminal() const { return game.activeCount <= 1; }
+
+    /// Seat that makes the next decision, or kNoSeat if terminal.
+    int toMove() const;
+
+    /// True if seat may block declared (role, alive, not the actor, can pay).
+    bool mayBlock(int seat) const;
+
+    /**
+     * @brief Fill out with the decisions available to toMove().
+     * @return The number of decisions written (at most kMaxDecisions).
+     */
+    int decisions(Decision* out) const;
+
+    /**
+     * @brief Play a decision for toMove().
+     * @return False (and no change) if the action was rejected.
+     */
+    bool play(const Decision& d);
+
+private:
+    /// Skip to the next eligible blocker, or close the window if none is left.
+    void advance();
+
+    /// Leave the window and end the turn unless the action was a Bribe.
+    void close();
+};
+
+static_assert(std::is_trivially_copyable<SearchState>::value,
+              "SearchState must stay trivially copyable");
@@ -0,0 +1,536 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../include/Agent.hpp"
+#include "../include/Baron.hpp"
+#include "../include/Exceptions.hpp"
+#include "../include/Game.hpp"
+#include "../include/General.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Judge.hpp"
+#include "../include/MatchArena.hpp"
+#include "../include/Merchant.hpp"
+#include "../include/Player.hpp"
+#include "../include/Spy.hpp"
+
+/**
+ * @brief Microbenchmarks for the engine's hot paths.
+ *
+ * Each benchmark runs its body with a growing op count until one run takes
+ * at least the minimum time, then reports, per op: wall-clock nanoseconds,
+ * heap allocations (counted by the operator new below) and retired
+ * instructions (perf_event_open; null where the kernel refuses it).
+ *
+ * Usage:
+ *   engine_bench [--json file] [--min-time seconds] [filter]
+ *
+ * The match benchmarks set up and tear down one six-player match per op,
+ * so their ns/op times 10^6 is the cost of a million matches.
+ *
+ * Only benchmarks whose name contains filter are run. The table goes to
+ * stdout; --json also writes the results for regression tracking.
+ */
+
+//
+// Allocation counting: every global allocation goes through here. Kept out
+// of line so GCC does not pair the inlined malloc/free across them.
+//
+namespace {
+std::uint64_t gAllocs = 0;
+bool          gCounting = false;
+}
+
+__attribute__((noinline)) void* operator new(std::size_t n) {
+    if (gCounting) ++gAllocs;
+    void* p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+//
+// Retired user-space instructions of this thread, if perf events are allowed.
+//
+class InstructionCounter {
+public:
+    InstructionCounter() : _fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~InstructionCounter() {
+#ifdef __linux__
+        if (_fd >= 0) close(_fd);
+#endif
+    }
+
+    bool available() const { return _fd >= 0; }
+
+    void enable() {
+#ifdef __linux__
+        if (_fd >= 0) ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    void disable() {
+#ifdef __linux__
+        if (_fd >= 0) ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+    }
+
+    void reset() {
+#ifdef __linux__
+        if (_fd >= 0) ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+#endif
+    }
+
+    std::uint64_t read() const {
+        std::uint64_t count = 0;
+#ifdef __linux__
+        if (_fd >= 0 && ::read(_fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+        return count;
+    }
+
+private:
+    int _fd;
+};
+
+//
+// Accumulates time, allocations and instructions while running. Bodies
+// pause it around setup that should not be measured.
+//
+class Meter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Meter(InstructionCounter& ic) : _ic(ic), _ns(0), _allocs(0) {}
+
+    void resume() {
+        _allocStart = gAllocs;
+        gCounting = true;
+        _ic.enable();
+        _start = Clock::now();
+    }
+
+    void pause() {
+        Clock::time_point end = Clock::now();
+        _ic.disable();
+        gCounting = false;
+        _ns += std::chrono::duration<double, std::nano>(end - _start).count();
+        _allocs += gAllocs - _allocStart;
+    }
+
+    double ns() const { return _ns; }
+    std::uint64_t allocs() const { return _allocs; }
+
+private:
+    InstructionCounter& _ic;
+    Clock::time_point   _start;
+    double              _ns;
+    std::uint64_t       _allocs;
+    std::uint64_t       _allocStart;
+};
+
+struct Result {
+    std::string name;
+    long        ops;
+    double      nsPerOp;
+    double      allocsPerOp;
+    double      instructionsPerOp;  // < 0 when unavailable
+};
+
+using Body = void (*)(Meter&, long ops);
+
+Result measure(const std::string& name, Body body, double minSeconds, InstructionCounter& ic) {
+    long ops = 1;
+    for (;;) {
+        Meter m(ic);
+        ic.reset();
+        m.resume();
+        body(m, ops);
+        m.pause();
+        double secs = m.ns() / 1e9;
+        if (secs >= minSeconds || ops >= (1L << 40)) {
+            double instr = ic.available() ? static_cast<double>(ic.read()) / ops : -1.0;
+            return {name, ops, m.ns() / ops, static_cast<double>(m.allocs()) / ops, instr};
+        }
+        double grow = secs > 0 ? 1.4 * minSeconds / secs : 100.0;
+        if (grow > 100.0) grow = 100.0;
+        if (grow < 2.0) grow = 2.0;
+        ops = static_cast<long>(ops * grow);
+    }
+}
+
+//
+// Fixtures
+//
+
+/// A six-player table, one of each role, seated in role order. The roles
+/// are the shared built-in instances, so building a table allocates none.
+struct Table {
+    Game   game;
+    Player gov{"Governor", RoleId::Governor, &game};
+    Player spy{"Spy", RoleId::Spy, &game};
+    Player baron{"Baron", RoleId::Baron, &game};
+    Player general{"General", RoleId::General, &game};
+    Player judge{"Judge", RoleId::Judge, &game};
+    Player merchant{"Merchant", RoleId::Merchant, &game};
+
+    Table() {
+        for (Player* p : {&gov, &spy, &baron, &general, &judge, &merchant}) game.addPlayer(p);
+    }
+};
+
+// Keeps the optimizer from discarding results.
+volatile std::size_t gSink;
+
+//
+// Benchmarks
+//
+void benchNextTurn(Meter& m, long ops) {
+    m.pause();
+    Table t;
+    m.resume();
+    for (long i = 0; i < ops; ++i) t.game.nextTurn();
+}
+
+void benchRegisterAction(Meter& m, long ops) {
+    m.pause();
+    GameState s;
+    int seat = s.addSeat(RoleId::Governor, GameState::abilitiesOf(RoleId::Governor), 0);
+    m.resume();
+    for (long i = 0; i < ops; ++i) {
+        if (s.pendingCount == GameState::kMaxPending) {
+            m.pause();
+            s.processPending();
+            m.resume();
+        }
+        s.registerAction(ActionType::Tax, seat, GameState::kNoSeat);
+    }
+}
+
+// processPending with N live entries; each op includes the N registerAction
+// calls that fill the table (see registerAction for their share).
+template <int N>
+void benchProcessPending(Meter& m, long ops) {
+    m.pause();
+    GameState s;
+    for (int i = 0; i < 6; ++i) {
+        RoleId r = static_cast<RoleId>(i);
+        s.addSeat(r, GameState::abilitiesOf(r), 0);
+    }
+    m.resume();
+    for (long i = 0; i < ops; ++i) {
+        for (int k = 0; k < N; ++k) {
+            s.registerAction(ActionType::Tax, k % 6, GameState::kNoSeat);
+        }
+        s.processPending();
+    }
+    gSink = static_cast<std::size_t>(s.coins[0]);
+}
+
+// register + block through the Game facade; tombstones are cleared (and
+// coins topped up) every 32 ops, outside the measurement.
+enum class Blocked { Tax, Bribe, Arrest, Sanction, Coup };
+
+template <Blocked B>
+void benchBlock(Meter& m, long ops) {
+    m.pause();
+    Table t;
+    Game& g = t.game;
+    m.resume();
+    for (long i = 0; i < ops; ++i) {
+        if (i % 32 == 0) {
+            m.pause();
+            g.state().processPending();
+            if (B == Blocked::Sanction) t.baron.addCoins(32);
+            if (B == Blocked::Coup)     t.general.addCoins(5 * 32);
+            m.resume();
+        }
+        switch (B) {
+            case Blocked::Tax:
+                g.registerTax(&t.gov);
+                g.blockTax(&t.spy, &t.gov);
+                break;
+            case Blocked::Bribe:
+                g.registerBribe(&t.merchant);
+                g.blockBribe(&t.judge, &t.merchant);
+                break;
+            case Blocked::Arrest:
+                g.registerArrest(&t.baron, &t.merchant);
+                g.blockArrest(&t.spy, &t.merchant);
+                break;
+            case Blocked::Sanction:
+                g.registerSanction(&t.baron, &t.merchant);
+                g.blockSanction(&t.judge, &t.merchant);
+                break;
+            case Blocked::Coup:
+                g.registerCoup(&t.baron, &t.merchant);
+                g.blockCoup(&t.general, &t.merchant);
+                break;
+        }
+    }
+}
+
+// A Gather by a player whose turn it is not: rejected first as a result
+// code (tryGather), then as the NotYourTurn exception (gather).
+void benchOffTurnTryGather(Meter& m, long ops) {
+    m.pause();
+    Table t;
+    m.resume();
+    for (long i = 0; i < ops; ++i) gSink = static_cast<std::size_t>(t.spy.tryGather());
+}
+
+void benchOffTurnGatherThrow(Meter& m, long ops) {
+    m.pause();
+    Table t;
+    m.resume();
+    for (long i = 0; i < ops; ++i) {
+        try {
+            t.spy.gather();
+        } catch (const NotYourTurn&) {
+            ++gSink;
+        }
+    }
+}
+
+// One op is a round of six Gathers; coins are reset before anyone must coup.
+void benchGatherRound(Meter& m, long ops) {
+    m.pause();
+    Table t;
+    Player* const seats[] = {&t.gov, &t.spy, &t.baron, &t.general, &t.judge, &t.merchant};
+    m.resume();
+    for (long i = 0; i < ops; ++i) {
+        if (i % 8 == 7) {
+            m.pause();
+            for (Player* p : seats) p->removeCoins(p->coins());
+            m.resume();
+        }
+        for (Player* p : seats) p->gather();
+    }
+}
+
+void benchApplyBatch(Meter& m, long ops) {
+    m.pause();
+    Table t;
+    Player* const seats[] = {&t.gov, &t.spy, &t.baron, &t.general, &t.judge, &t.merchant};
+    const Action round[6] = {
+        {ActionType::Gather, GameState::kNoSeat}, {ActionType::Gather, GameState::kNoSeat},
+        {ActionType::Gather, GameState::kNoSeat}, {ActionType::Gather, GameState::kNoSeat},
+        {ActionType::Gather, GameState::kNoSeat}, {ActionType::Gather, GameState::kNoSeat},
+    };
+    m.resume();
+    for (long i = 0; i < ops; ++i) {
+        if (i % 8 == 7) {
+            m.pause();
+            for (Player* p : seats) p->removeCoins(p->coins());
+            m.resume();
+        }
+        gSink = t.game.applyBatch(round, 6).index;
+    }
+}
+
+void benchPlayers(Meter& m, long ops) {
+    m.pause();
+    Table t;
+    m.resume();
+    for (long i = 0; i < ops; ++i) gSink = t.game.players().size();
+}
+
+void benchTurn(Meter& m, long ops) {
+    m.pause();
+    Table t;
+    m.resume();
+    for (long i = 0; i < ops; ++i) gSink = t.game.turn().size();
+}
+
+// addPlayer into a fresh game until the table is full; Game and Player
+// construction happen outside the measurement.
+void benchAddPlayer(Meter& m, long ops) {
+    m.pause();
+    std::vector<std::string> names;
+    for (int i = 0; i < GameState::kMaxPlayers; ++i) names.push_back("p" + std::to_string(i));
+    for (long done = 0; done < ops;) {
+        std::unique_ptr<Game> g(new Game());
+        std::vector<std::unique_ptr<Player>> players;
+        int batch = static_cast<int>(std::min<long>(GameState::kMaxPlayers, ops - done));
+        for (int i = 0; i < batch; ++i) {
+            players.emplace_back(new Player(names[i], std::make_unique<Spy>(), g.get()));
+        }
+        m.resume();
+        for (int i = 0; i < batch; ++i) g->addPlayer(players[i].get());
+        m.pause();
+        done += batch;
+    }
+    m.resume();
+}
+
+// One full match of uniformly random legal moves on the flat engine.
+void benchPlayout(Meter& m, long ops) {
+    m.pause();
+    GameState initial;
+    for (int i = 0; i < 6; ++i) {
+        RoleId r = static_cast<RoleId>(i);
+        initial.addSeat(r, GameState::abilitiesOf(r), 0);
+    }
+    RandomAgent agent;
+    const Agent* agents[6] = {&agent, &agent, &agent, &agent, &agent, &agent};
+    std::mt19937_64 rng(1);
+    m.resume();
+    for (long i = 0; i < ops; ++i) {
+        GameState s = initial;
+        gSink = static_cast<std::size_t>(playOut(s, agents, rng, 1000).turns);
+    }
+}
+
+// Create and destroy a match as Demo.cpp does: a Game plus six Players and
+// Roles from new / make_unique.
+void benchMatchHeap(Meter& m, long ops) {
+    for (long i = 0; i < ops; ++i) {
+        std::unique_ptr<Game> g(new Game());
+        std::unique_ptr<Player> players[6] = {
+            std::unique_ptr<Player>(new Player("Governor", std::make_unique<Governor>(), g.get())),
+            std::unique_ptr<Player>(new Player("Spy", std::make_unique<Spy>(), g.get())),
+            std::unique_ptr<Player>(new Player("Baron", std::make_unique<Baron>(), g.get())),
+            std::unique_ptr<Player>(new Player("General", std::make_unique<General>(), g.get())),
+            std::unique_ptr<Player>(new Player("Judge", std::make_unique<Judge>(), g.get())),
+            std::unique_ptr<Player>(new Player("Merchant", std::make_unique<Merchant>(), g.get())),
+        };
+        for (auto& p : players) g->addPlayer(p.get());
+    }
+    (void)m;
+}
+
+// The same match in a MatchArena that is reset between matches.
+void benchMatchArena(Meter& m, long ops) {
+    m.pause();
+    MatchArena arena;
+    m.resume();
+    for (long i = 0; i < ops; ++i) {
+        arena.addPlayer<Governor>("Governor");
+        arena.addPlayer<Spy>("Spy");
+        arena.addPlayer<Baron>("Baron");
+        arena.addPlayer<General>("General");
+        arena.addPlayer<Judge>("Judge");
+        arena.addPlayer<Merchant>("Merchant");
+        arena.reset();
+    }
+}
+
+struct Entry {
+    const char* name;
+    Body        body;
+};
+
+const Entry kBenchmarks[] = {
+    {"Game::nextTurn",              benchNextTurn},
+    {"GameState::registerAction",   benchRegisterAction},
+    {"processPending/1",            benchProcessPending<1>},
+    {"processPending/2",            benchProcessPending<2>},
+    {"processPending/4",            benchProcessPending<4>},
+    {"processPending/8",            benchProcessPending<8>},
+    {"processPending/16",           benchProcessPending<16>},
+    {"processPending/32",           benchProcessPending<32>},
+    {"processPending/64",           benchProcessPending<64>},
+    {"Game::blockTax",              benchBlock<Blocked::Tax>},
+    {"Game::blockBribe",            benchBlock<Blocked::Bribe>},
+    {"Game::blockArrest",           benchBlock<Blocked::Arrest>},
+    {"Game::blockSanction",         benchBlock<Blocked::Sanction>},
+    {"Game::blockCoup",             benchBlock<Blocked::Coup>},
+    {"Player::tryGather/offturn",   benchOffTurnTryGather},
+    {"Player::gather/offturn-throw", benchOffTurnGatherThrow},
+    {"Player::gather/round",        benchGatherRound},
+    {"Game::applyBatch/round",      benchApplyBatch},
+    {"Game::players",               benchPlayers},
+    {"Game::turn",                  benchTurn},
+    {"Game::addPlayer",             benchAddPlayer},
+    {"playout/random",              benchPlayout},
+    {"match/heap",                  benchMatchHeap},
+    {"match/arena",                 benchMatchArena},
+};
+
+void writeJson(const char* path, const std::vector<Result>& results, bool instructions) {
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) {
+        std::fprintf(stderr, "cannot write %s\n", path);
+        return;
+    }
+    std::fprintf(f, "{\n  \"instructions_available\": %s,\n  \"benchmarks\": [\n",
+                 instructions ? "true" : "false");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(f, "    {\"name\": \"%s\", \"ops\": %ld, \"ns_per_op\": %.3f, "
+                        "\"allocs_per_op\": %.3f, \"instructions_per_op\": ",
+                     r.name.c_str(), r.ops, r.nsPerOp, r.allocsPerOp);
+        if (r.instructionsPerOp < 0) std::fprintf(f, "null");
+        else                         std::fprintf(f, "%.1f", r.instructionsPerOp);
+        std::fprintf(f, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    std::fclose(f);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* json = nullptr;
+    const char* filter = "";
+    double minSeconds = 0.2;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc)          json = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc) minSeconds = std::atof(argv[++i]);
+        else if (arg[0] != '-')                       filter = argv[i];
+        else {
+            std::fprintf(stderr, "usage: engine_bench [--json file] [--min-time seconds] [filter]\n");
+            return 1;
+        }
+    }
+
+    InstructionCounter ic;
+    std::vector<Result> results;
+    std::printf("%-30s %12s %12s %12s\n", "benchmark", "ns/op", "allocs/op", "instr/op");
+    for (const Entry& e : kBenchmarks) {
+        if (std::strstr(e.name, filter) == nullptr) continue;
+        Result r = measure(e.name, e.body, minSeconds, ic);
+        if (r.instructionsPerOp < 0) {
+            std::printf("%-30s %12.1f %12.2f %12s\n", r.name.c_str(), r.nsPerOp, r.allocsPerOp, "n/a");
+        } else {
+            std::printf("%-30s %12.1f %12.2f %12.0f\n", r.name.c_str(), r.nsPerOp, r.allocsPerOp,
+                        r.instructionsPerOp);
+        }
+        std::fflush(stdout);
+        results.push_back(r);
+    }
+    if (json) writeJson(json, results, ic.available());
+    return 0;
+}
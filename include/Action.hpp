@@ -0,0 +1,12 @@
+#pragma once
+
+#include "ActionType.hpp"
+
+/**
+ * @brief One move for the flat engine: the action type and, for Arrest,
+ * Sanction and Coup, the target seat (GameState::kNoSeat otherwise).
+ */
+struct Action {
+    ActionType type;
+    int        target;
+};
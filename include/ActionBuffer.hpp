@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Action.hpp"
+#include "GameState.hpp"
+
+/**
+ * @brief Caller-owned, fixed-capacity list of actions.
+ *
+ * Large enough for every legal move of one player (Gather, Tax, Bribe and one
+ * Arrest, Sanction and Coup per opponent), so filling it never allocates.
+ */
+class ActionBuffer {
+public:
+    static constexpr int kCapacity = 3 + 3 * GameState::kMaxPlayers;
+
+    ActionBuffer() : _size(0) {}
+
+    /// Remove all actions.
+    void clear() { _size = 0; }
+
+    /// Append an action (ignored if the buffer is full).
+    void push(ActionType type, int target) {
+        if (_size < kCapacity) _items[_size++] = {type, target};
+    }
+
+    int size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    const Action& operator[](int i) const { return _items[i]; }
+    const Action* begin() const { return _items; }
+    const Action* end() const { return _items + _size; }
+
+private:
+    Action _items[kCapacity];  ///< Storage; only the first _size entries are valid.
+    int    _size;              ///< Number of valid entries.
+};
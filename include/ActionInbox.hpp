@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "ActionType.hpp"
+
+/**
+ * @brief A pending-action change sent to a Game from another thread.
+ */
+struct InboxCommand {
+    enum Kind : std::uint8_t {
+        Register,  ///< seat declares an action of type on target (Game::declare).
+        Block      ///< seat blocks the pending action of type on target (GameState::block).
+    };
+
+    Kind          kind;
+    ActionType    type;
+    std::int8_t   seat;    ///< Actor (Register) or blocker (Block).
+    std::int8_t   target;  ///< Register: target seat (kNoSeat for Tax, Bribe). Block: the seat whose action is blocked.
+    std::uint32_t tag;     ///< Caller's id for the command, handed back with its result.
+};
+
+/**
+ * @brief Bounded multi-producer, single-consumer lock-free queue of
+ * InboxCommands.
+ *
+ * Any number of threads may push(); only the thread that owns the Game may
+ * pop(). Each cell carries a sequence number telling whose turn it is to
+ * use it (D. Vyukov's bounded queue): a producer claims a cell by advancing
+ * the shared tail with one compare-and-swap, fills it and publishes it by
+ * bumping the cell's sequence; the consumer reads cells in order and hands
+ * them back. Nothing blocks and nothing allocates. Commands from one
+ * producer are popped in the order it pushed them.
+ */
+class ActionInbox {
+public:
+    static constexpr std::size_t kCapacity = 256;  ///< Power of two.
+
+    ActionInbox() : _tail(0), _head(0) {
+        for (std::size_t i = 0; i < kCapacity; ++i) _cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    ActionInbox(const ActionInbox&) = delete;
+    ActionInbox& operator=(const ActionInbox&) = delete;
+
+    /**
+     * @brief Enqueue a command. Safe from any thread.
+     * @return False if the inbox is full (the command is dropped).
+     */
+    bool push(const InboxCommand& command) {
+        std::size_t pos = _tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = _cells[pos & (kCapacity - 1)];
+            std::size_t seq = cell.seq.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.command = command;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Dequeue the oldest published command. Owning thread only.
+     * @return False if there is none.
+     */
+    bool pop(InboxCommand& out) {
+        Cell& cell = _cells[_head & (kCapacity - 1)];
+        if (cell.seq.load(std::memory_order_acquire) != _head + 1) {
+            return false;
+        }
+        out = cell.command;
+        cell.seq.store(_head + kCapacity, std::memory_order_release);
+        ++_head;
+        return true;
+    }
+
+    /// True if nothing is ready to pop. Owning thread only.
+    bool empty() const {
+        return _cells[_head & (kCapacity - 1)].seq.load(std::memory_order_acquire) != _head + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq;  ///< pos: free for producer pos; pos + 1: holds command pos.
+        InboxCommand             command;
+    };
+
+    alignas(64) std::atomic<std::size_t> _tail;  ///< Next position producers claim.
+    alignas(64) std::size_t              _head;  ///< Next position the consumer reads.
+    alignas(64) Cell                     _cells[kCapacity];
+};
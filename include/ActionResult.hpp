@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Outcome of a rules check in GameState (no strings, no exceptions).
+ */
+enum class ActionResult : std::uint8_t {
+    Ok,
+    NotYourTurn,    ///< The acting seat is not the current player.
+    NotAllowed,     ///< The seat's role does not permit this action.
+    OutOfCoins,     ///< The paying seat does not have enough coins.
+    SelfTarget,     ///< The action may not target its own actor.
+    InvalidPlayer,  ///< The seat is not (or no longer) in play.
+    NoPending,      ///< There is no matching pending action to block.
+    PoolEmpty,      ///< The central pool cannot cover the request.
+    TableFull       ///< No free seat or pending-action slot is left.
+};
+
+/**
+ * @brief Name of a result code ("Ok", "NotYourTurn", ...).
+ */
+inline const char* actionResultName(ActionResult r) {
+    static const char* const kNames[] = {
+        "Ok", "NotYourTurn", "NotAllowed", "OutOfCoins", "SelfTarget",
+        "InvalidPlayer", "NoPending", "PoolEmpty", "TableFull"
+    };
+    return kNames[static_cast<int>(r)];
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include "Action.hpp"
+#include "GameState.hpp"
+
+/**
+ * @brief A headless player policy for self-play on a GameState.
+ *
+ * Agents are stateless and const, so a single instance can be shared by all
+ * simulator threads; randomness comes from the caller's generator.
+ */
+class Agent {
+public:
+    virtual ~Agent() = default;
+
+    /**
+     * @brief Pick a move for seat, which is the current player of state.
+     * The move may turn out illegal; callers fall back to Gather.
+     * @param state The current match state.
+     * @param seat  The seat to move for.
+     * @param rng   Caller-owned random generator.
+     * @return The chosen action.
+     */
+    virtual Action choose(const GameState& state, int seat, std::mt19937_64& rng) const = 0;
+
+    /**
+     * @brief Short name used on the command line and in reports.
+     */
+    virtual const char* name() const = 0;
+};
+
+/**
+ * @brief Picks uniformly among the seat's legal moves.
+ */
+class RandomAgent : public Agent {
+public:
+    Action choose(const GameState& state, int seat, std::mt19937_64& rng) const override;
+    const char* name() const override { return "random"; }
+};
+
+/**
+ * @brief Greedy policy: coup the richest opponent (random among ties) when
+ * affordable, otherwise take the highest-yield income action the role allows.
+ */
+class HeuristicAgent : public Agent {
+public:
+    Action choose(const GameState& state, int seat, std::mt19937_64& rng) const override;
+    const char* name() const override { return "heuristic"; }
+};
+
+/**
+ * @brief Create an agent by name ("random" or "heuristic").
+ * @return The agent, or nullptr if the name is unknown.
+ */
+std::unique_ptr<Agent> makeAgent(const std::string& name);
+
+/**
+ * @brief Outcome of one self-play match.
+ */
+struct PlayoutResult {
+    int winner;  ///< Winning seat, or GameState::kNoSeat if the turn limit was hit.
+    int turns;   ///< Number of actions taken.
+};
+
+/**
+ * @brief Play state to the end with one agent per seat.
+ * Illegal choices fall back to Gather, which is always legal on one's turn.
+ * @param state    The match to play; modified in place.
+ * @param agents   Agent per seat (indexed by seat).
+ * @param rng      Random generator for the agents.
+ * @param maxTurns Stop after this many actions and report no winner.
+ */
+PlayoutResult playOut(GameState& state, const Agent* const* agents,
+                      std::mt19937_64& rng, int maxTurns);
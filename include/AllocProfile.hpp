@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @brief Opt-in heap allocation profiler with per-call-site attribution.
+ *
+ * In a build with COUP_ALLOC_PROFILE defined (`make profile`), a global
+ * operator new counts every allocation and its size against the innermost
+ * ALLOC_SITE scope active on the calling thread: Game::nextTurn, each
+ * Player action, each Game::block*, and the other engine entry points that
+ * are marked. Allocations outside any scope go to the "(unattributed)"
+ * site. The table can be read with stats() or report(), and is printed to
+ * stderr when the program exits.
+ *
+ * In a normal build ALLOC_SITE expands to nothing, no operator new is
+ * replaced and every query returns zeros.
+ */
+namespace AllocProfile {
+
+/**
+ * @brief Counters of one call site.
+ */
+struct SiteStats {
+    const char*   site;    ///< Name given to ALLOC_SITE.
+    std::uint64_t calls;   ///< Times the scope was entered.
+    std::uint64_t allocs;  ///< Allocations made directly in the scope (not in nested scopes).
+    std::uint64_t bytes;   ///< Bytes requested by those allocations.
+};
+
+/// Most distinct sites one program can mark.
+constexpr int kMaxSites = 64;
+
+/// True in a COUP_ALLOC_PROFILE build.
+bool enabled();
+
+/**
+ * @brief Id of a named site, registering it on first use. Names are
+ * compared by content; the pointer must stay valid (use a literal).
+ * @return The id, or 0 (the unattributed site) once the table is full.
+ */
+int registerSite(const char* name);
+
+/**
+ * @brief Count one allocation of bytes against the current thread's site.
+ * Called by the operator new hook.
+ */
+void noteAllocation(std::size_t bytes);
+
+/// Counters of a site, by name; all zero if the site was never entered.
+SiteStats stats(const char* site);
+
+/**
+ * @brief Copy every registered site into out.
+ * @return The number of sites written (at most kMaxSites).
+ */
+int snapshot(SiteStats* out);
+
+/// Zero every counter; sites stay registered.
+void reset();
+
+/// Print the sites that allocated, with allocations and bytes per call.
+void report(std::FILE* out);
+
+/**
+ * @brief RAII marker: allocations until destruction belong to site, unless
+ * a nested scope claims them. Use through ALLOC_SITE.
+ */
+class Scope {
+public:
+    explicit Scope(int site);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    int _previous;
+};
+
+} // namespace AllocProfile
+
+#ifdef COUP_ALLOC_PROFILE
+#define ALLOC_SITE(name)                                                      \
+    static const int allocSiteId_ = AllocProfile::registerSite(name);         \
+    AllocProfile::Scope allocScope_(allocSiteId_)
+#else
+#define ALLOC_SITE(name) ((void)0)
+#endif
@@ -9,7 +9,7 @@
  *   - specialAction(): “Invest” — pay 3 coins and immediately gain 6.
  *   - onSanctioned(): if sanctioned, gain +1 coin compensation.
  */
-class Baron : public Role, virtual Player {
+class Baron final : public Role {
 public:
     Baron();
     ~Baron() override = default;
@@ -30,6 +30,9 @@ public:
     /// @copydoc Role::name
     std::string name() const override { return "Baron"; }
 
+    /// @copydoc Role::id
+    RoleId id() const override { return RoleId::Baron; }
+
     /// @copydoc Role::clone
     std::unique_ptr<Role> clone() const override {
         return std::make_unique<Baron>(*this);
@@ -4,9 +4,16 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <unordered_map>
 #include "Player.hpp"
 #include "Exceptions.hpp"
 #include "ActionType.hpp"
+#include "GameState.hpp"
+#include "ActionBuffer.hpp"
+#include "UndoJournal.hpp"
+#include "ObservationLog.hpp"
+#include "ReplayLog.hpp"
+#include "ActionInbox.hpp"
 
 
 
@@ -16,29 +23,51 @@
  *   - Registers pending actions that can be blocked (Tax, Bribe, Arrest, Sanction, Coup).
  *   - Allows roles to block those pending actions.
  *   - Processes pending actions at the start of each nextTurn().
+ *
+ * All rules and data live in a flat GameState; Game maps Player objects to
+ * seats and turns rule violations into exceptions.
+ *
+ * Once every player has been added, a legal turn does not touch the heap:
+ * turn(), the Player actions, block*() and nextTurn() (with processPending())
+ * work on fixed-size storage only. Allocation is left to the failure path
+ * (exception messages), players(), winner() and an attached ObservationLog.
+ * tests/test_SteadyState.cpp enforces this.
  */
-class Game {
+class Game : private RoleHooks {
+    friend class Player;
+
 public:
     Game();
     ~Game();
 
     /**
-     * @brief Add a new player to the game.
+     * @brief Add a new player to the game and give it the next dense integer id.
      * Throws IllegalAction if name is duplicate or player pointer is null.
      * @param player A pointer to a dynamically allocated Player.
      */
     void addPlayer(Player* player);
 
+    /**
+     * @brief Id of the active player with the given name (hashed lookup).
+     * @param name The player name.
+     * @return The player's id, or GameState::kNoSeat if no active player has it.
+     */
+    int idOf(const std::string& name) const;
+
     /**
      * @brief Returns the name of the player whose turn it currently is.
-     * @return The current turn’s player name.
+     * @return The current turn’s player name (valid while that Player lives).
      */
-    std::string turn() const;
+    const std::string& turn() const;
 
     /**
      * @brief Advance to the next player’s turn.
-     * First processes any pending actions, then advances currentIndex,
-     * and finally invokes onStartTurn() for the new current player.
+     * First applies the commands waiting in the action inbox (see post()),
+     * then processes any pending actions, then advances currentIndex,
+     * and finally applies the new current player's start-of-turn bonus.
+     * Built-in roles take it (and their arrest and sanction effects) from
+     * kRoleRules; only RoleId::Custom players have Player::onStartTurn(),
+     * handleArrested() and handleSanctioned() called.
      */
     void nextTurn();
 
@@ -90,6 +119,16 @@ public:
      */
     bool mustCoup(const Player& p) const;
 
+    /**
+     * @brief Fill out with every legal (ActionType, target seat) pair for p;
+     * targets are seats (see playerAt()).
+     * Uses the role's abilities, the coin thresholds and mustCoup(). Throws
+     * nothing and never allocates; out is empty if it is not p's turn.
+     * @param p   The player to generate moves for.
+     * @param out Caller-owned buffer, cleared first.
+     */
+    void legalActions(const Player& p, ActionBuffer& out) const;
+
     /** @name Registering pending actions that can be blocked */
     ///@{
     void registerTax(Player* actor);
@@ -97,6 +136,15 @@ public:
     void registerArrest(Player* actor, Player* target);
     void registerSanction(Player* actor, Player* target);
     void registerCoup(Player* actor, Player* target);
+
+    /**
+     * @brief Play seat's action up to its block window: the checks, cost and
+     * registration of the matching Player method (GameState::declare()),
+     * without the nextTurn() that would resolve it at once. Logged like a
+     * Player action once it succeeds. Targets are seats.
+     * @return The rule check result; nothing changes unless it is Ok.
+     */
+    ActionResult declare(int seat, const Action& action);
     ///@}
 
     /** @name Blocking methods (called by Role::blockX) */
@@ -108,20 +156,227 @@ public:
     void blockCoup(Player* blocker, Player* target);
     ///@}
 
-private:
+    /** @name Action sequences
+     * One call for a scripted sequence, with nothing shared between its
+     * entries: each gets its own turn check and, as with the Player
+     * methods, its own nextTurn() and resolution, so the cost is that of
+     * the same calls made one by one, less the exceptions.
+     */
+    ///@{
     /**
-     * @brief Internal struct representing a pending action that may be blocked.
+     * @brief Outcome of applyBatch(): how many actions were played and why
+     * the next one was not.
      */
-    struct PendingAction {
-        Player* actor;    ///< The player who initiated the action.
-        Player* target;   ///< The target player (nullptr if none).
-        ActionType type;  ///< The type of action.
+    struct BatchResult {
+        std::size_t  index;   ///< First rejected action, or the batch size if all were played.
+        ActionResult reason;  ///< Its rule check result, or Ok.
     };
 
-    std::vector<Player*>       _players;   ///< Active players (in join order).
-    size_t                     _currentIndex; ///< Index in _players of whose turn it is.
-    int                        _poolCoins; ///< Number of coins in the central pool.
-    std::vector<PendingAction> _pending;   ///< List of pending actions that can be blocked.
+    /**
+     * @brief One entry of a mixed batch: an action for whoever's turn it
+     * is, or a block by any seat of an action still pending (e.g. a Judge
+     * blocking the Bribe played just before it, whose turn has not ended).
+     */
+    struct BatchStep {
+        enum Kind : std::uint8_t { Act, Block };
+
+        Kind   kind;
+        Action action;   ///< Act: the move. Block: the blocked type and the key seat (actor for Tax/Bribe, target otherwise).
+        int    blocker;  ///< Block: the blocking seat. Unused for Act.
+
+        static BatchStep act(const Action& a) { return {Act, a, GameState::kNoSeat}; }
+        static BatchStep block(int blocker, ActionType type, int target) { return {Block, {type, target}, blocker}; }
+    };
+
+    /**
+     * @brief Play count actions in order, each for whoever's turn it then
+     * is, exactly as the matching Player methods would (observation log,
+     * replay and the nextTurn() that follows all but Bribe), but with the
+     * target given as a seat and the result returned instead of thrown.
+     * Stops at the first rejected action, which changes nothing.
+     */
+    BatchResult applyBatch(const Action* actions, std::size_t count);
+
+    /// applyBatch() over a whole vector.
+    BatchResult applyBatch(const std::vector<Action>& actions) {
+        return applyBatch(actions.data(), actions.size());
+    }
+
+    /**
+     * @brief applyBatch() with blocks in between: Act steps are played as
+     * above, Block steps are applied like a posted InboxCommand::Block
+     * (see post()), so the blocker's role must be able to block the action
+     * and it may not be the blocker's own (NotAllowed otherwise). Stops at
+     * the first rejected step.
+     */
+    BatchResult applySteps(const BatchStep* steps, std::size_t count);
+
+    /// applySteps() over a whole vector.
+    BatchResult applySteps(const std::vector<BatchStep>& steps) {
+        return applySteps(steps.data(), steps.size());
+    }
+    ///@}
+
+    /** @name Make / unmake (tree search) */
+    ///@{
+    /**
+     * @brief Play action for the current player and record it for undo().
+     * Runs the same rules as the Player methods, including the nextTurn()
+     * resolution that follows every action except Bribe. Targets are seats.
+     * @return The rule check result; nothing is recorded unless it is Ok.
+     */
+    ActionResult apply(const Action& action);
+
+    /**
+     * @brief Take back the most recent apply(): coins, pool, turn index,
+     * pending actions and any player removed by a resolved Coup.
+     * Moves must be undone in reverse order with no other changes in between.
+     * @return False if there is nothing to undo.
+     */
+    bool undo();
+
+    /// Number of apply() calls that can still be undone.
+    std::size_t undoDepth() const { return _undo.depth(); }
+    ///@}
+
+    /**
+     * @brief Zobrist hash of the position (coins, roles, alive players, turn
+     * index, pool and pending actions), maintained incrementally.
+     * Equal positions hash equal, so it can key transposition tables.
+     */
+    std::uint64_t hash() const { return _state.hash; }
+
+    /** @name Observations (information-set search) */
+    ///@{
+    /**
+     * @brief Attach a log that receives joins, every successful Player action
+     * and block, and Spy reveals; nullptr detaches. The log is not owned.
+     */
+    void setObservationLog(ObservationLog* log) { _log = log; }
+
+    /// The attached observation log, or nullptr.
+    ObservationLog* observationLog() const { return _log; }
+    ///@}
+
+    /** @name Replay journal */
+    ///@{
+    /**
+     * @brief Attach a writer that receives every input event of the match
+     * (joins, actions, register*, block*, nextTurn, removals, undo, direct
+     * coin and pool changes) and the resolutions, turn starts and removals
+     * they cause; nullptr detaches. The writer is not owned. Framing the
+     * match (ReplayWriter::beginMatch() / endMatch()) is up to the caller.
+     */
+    void setReplayWriter(ReplayWriter* writer) { _replay = writer; }
+
+    /// The attached replay writer, or nullptr.
+    ReplayWriter* replayWriter() const { return _replay; }
+    ///@}
+
+    /** @name Action inbox
+     * The only Game calls that are safe from other threads are post() and
+     * the inbox itself; everything else, drainInbox() included, belongs to
+     * the thread that owns the match.
+     */
+    ///@{
+    /**
+     * @brief Queue a register or block from another thread (lock-free).
+     * It takes effect when the owning thread next drains the inbox, at the
+     * latest at the start of the next nextTurn(), so blocks sent during a
+     * block window are applied before the pending actions resolve.
+     * @return False if the inbox is full.
+     */
+    bool post(const InboxCommand& command) { return _inbox.push(command); }
+
+    /**
+     * @brief Apply every queued command in order, reporting each outcome
+     * instead of throwing: a Register as declare(), a Block as block*()
+     * with the role and self-block checks of GameState::block().
+     * @param onResult Called as onResult(const InboxCommand&, ActionResult).
+     * @return Number of commands taken from the inbox.
+     */
+    template <typename F>
+    std::size_t drainInbox(F&& onResult) {
+        InboxCommand command;
+        std::size_t n = 0;
+        while (_inbox.pop(command)) {
+            onResult(command, runCommand(command));
+            ++n;
+        }
+        return n;
+    }
+
+    /// drainInbox() with the outcomes discarded.
+    std::size_t drainInbox() {
+        return drainInbox([](const InboxCommand&, ActionResult) {});
+    }
+    ///@}
+
+    /** @name Snapshots */
+    ///@{
+    /// Format version, the first byte of every snapshot.
+    static constexpr std::uint8_t kSnapshotVersion = 1;
+
+    /**
+     * @brief Serialize the match into a compact blob (about 90 bytes for
+     * six players with short names).
+     *
+     * Layout, little-endian, with no padding:
+     *   - u8 version, u8 seat count, u8 active count, u8 current index,
+     *     u8 pending count, i32 pool;
+     *   - per seat: u8 role, u8 ability bits, i32 coins, u8 name length, name bytes;
+     *   - the turn order: one u8 seat per active player;
+     *   - per pending slot: u8 type, i8 actor, i8 target, u8 blocked.
+     *
+     * Throws IllegalAction if a name is longer than 255 bytes.
+     */
+    std::vector<std::uint8_t> snapshot() const;
+
+    /**
+     * @brief Load a snapshot into this game, reusing its Player objects.
+     *
+     * The game must have exactly as many seats as the snapshot. Seat s's
+     * Player takes the name, role and coins of seat s in the snapshot;
+     * built-in roles become the shared flyweights, and a seat with a custom
+     * role keeps the custom role its Player already has. The undo history is
+     * dropped; nothing is sent to the observation log or replay writer.
+     * The blob is checked in full before anything changes: on error this
+     * throws IllegalAction and the game is left as it was.
+     */
+    void restore(const std::uint8_t* data, std::size_t size);
+    void restore(const std::vector<std::uint8_t>& blob) { restore(blob.data(), blob.size()); }
+    ///@}
+
+    /** @name Flat state access (simulators, bots) */
+    ///@{
+    /**
+     * @brief The underlying flat state. Copying it is a single memcpy.
+     */
+    const GameState& state() const { return _state; }
+    GameState& state() { return _state; }
+
+    /**
+     * @brief The Player registered at a seat, or nullptr if the seat is unused.
+     * @param seat A seat handed out by addPlayer().
+     */
+    Player* playerAt(int seat) const;
+    ///@}
+
+private:
+    GameState _state;                          ///< All rules-relevant data.
+    Player*   _seats[GameState::kMaxPlayers];  ///< Player handle per seat (non-owning).
+    std::unordered_map<std::string, int> _ids; ///< Name → most recent seat with that name.
+    UndoJournal _undo;                         ///< Writes made by apply(), for undo().
+    ObservationLog* _log;                      ///< Receives public events, or nullptr.
+    ReplayWriter*   _replay;                   ///< Receives the replay journal, or nullptr.
+    ActionInbox     _inbox;                    ///< Commands posted by other threads.
+
+    /** @name RoleHooks (RoleId::Custom seats only) */
+    ///@{
+    void onStartTurn(int seat) override;
+    void onArrested(int seat) override;
+    void onSanctioned(int seat) override;
+    ///@}
 
     /**
      * @brief Return a pointer to the Player whose turn it is.
@@ -130,11 +385,35 @@ private:
     Player* getCurrentPlayer() const;
 
     /**
-     * @brief Returns true if the given player pointer is still active in _players.
-     * @param p The Player* to check.
-     * @return True if p is still present.
+     * @brief Seat of p in this game, or GameState::kNoSeat if p was never added here.
+     */
+    int seatOf(const Player* p) const;
+
+    /**
+     * @brief Run an action for seat (GameState::apply), recording it in the
+     * replay as an Apply (undoable) or an Act.
+     */
+    ActionResult play(int seat, const Action& action, bool undoable);
+
+    /**
+     * @brief Run a Player action for seat and log it if it succeeded.
+     */
+    ActionResult act(int seat, const Action& action);
+
+    /**
+     * @brief Apply one inbox command.
+     */
+    ActionResult runCommand(const InboxCommand& command);
+
+    /**
+     * @brief Log a successful block (observation log and replay).
+     */
+    void observeBlock(Player* blocker, ActionType type, Player* target);
+
+    /**
+     * @brief Re-key the name index when a seated Player is assigned a new name.
      */
-    bool isActive(Player* p) const;
+    void renamePlayer(int seat, const std::string& from, const std::string& to);
 
     /**
      * @brief Process all pending actions (Tax, Bribe, Arrest, Sanction, Coup).
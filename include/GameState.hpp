@@ -0,0 +1,325 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Action.hpp"
+#include "ActionType.hpp"
+#include "ActionResult.hpp"
+#include "RoleId.hpp"
+#include "RoleRules.hpp"
+
+class ActionBuffer;
+class UndoJournal;
+class ReplayWriter;
+
+/**
+ * @brief Start-of-turn, arrest and sanction hooks for seats whose role is
+ * RoleId::Custom, which kRoleRules cannot describe. Game implements it by
+ * calling the seat's Player.
+ */
+class RoleHooks {
+public:
+    virtual void onStartTurn(int seat) = 0;
+    virtual void onArrested(int seat) = 0;
+    virtual void onSanctioned(int seat) = 0;
+
+protected:
+    ~RoleHooks() = default;
+};
+
+/**
+ * @brief Flat, trivially copyable game state and the rules engine behind Game.
+ *
+ * Players are addressed by small integer seats handed out in join order; seats
+ * are never reused within a match. Everything lives in fixed-size arrays, so a
+ * copy of a GameState is a single memcpy. Game and Player are thin facades that
+ * forward to the GameState owned by the Game.
+ *
+ * Rule violations are reported as ActionResult codes; nothing here throws.
+ * Role-specific outcomes come from the kRoleRules table, indexed by the
+ * seat's RoleId, so resolution does no string work and no virtual calls;
+ * only RoleId::Custom seats go out through hooks.
+ *
+ * Every field write made by the methods below goes through set(), which logs
+ * the previous value to journal when one is attached (see Game::apply()).
+ * The same methods keep hash, a Zobrist hash of the position, up to date;
+ * code that writes fields directly must call rehash() afterwards.
+ */
+struct GameState {
+    static constexpr int kMaxPlayers   = 32;  ///< Seats per match (alive is a 32-bit mask).
+    static constexpr int kMaxPending   = 64;  ///< Pending actions between two turns.
+    static constexpr int kNoSeat       = -1;  ///< "No player" (untargeted or unseated).
+    static constexpr int kStartingPool = 50;  ///< Coins in the pool at the start of a match.
+    static constexpr int kActionTypes  = 6;   ///< Number of ActionType values.
+    static constexpr int kPendingKeys  = kMaxPlayers + 1;  ///< Seats plus kNoSeat.
+
+    /**
+     * @brief Ability bits cached from Role::canX() when a seat is assigned.
+     */
+    enum Ability : std::uint8_t {
+        CanGather   = 1 << 0,
+        CanTax      = 1 << 1,
+        CanBribe    = 1 << 2,
+        CanArrest   = 1 << 3,
+        CanSanction = 1 << 4,
+        CanCoup     = 1 << 5
+    };
+
+    /**
+     * @brief Ability bits of a built-in role, matching its Role::canX() overrides.
+     * Used when seating players without Role objects (simulators, bots).
+     */
+    static constexpr std::uint8_t abilitiesOf(RoleId role) {
+        return CanGather
+             | (rulesOf(role).canTax      ? CanTax      : 0)
+             | (rulesOf(role).canBribe    ? CanBribe    : 0)
+             | (rulesOf(role).canArrest   ? CanArrest   : 0)
+             | (rulesOf(role).canSanction ? CanSanction : 0);
+    }
+
+    /**
+     * @brief True if a built-in role can block actions of the given type
+     * (Governor: Tax, Judge: Bribe, Spy: Arrest, General: Coup).
+     */
+    static constexpr bool canBlock(RoleId role, ActionType type) {
+        return (type == ActionType::Tax    && rulesOf(role).blocksTax)
+            || (type == ActionType::Bribe  && rulesOf(role).blocksBribe)
+            || (type == ActionType::Arrest && rulesOf(role).blocksArrest)
+            || (type == ActionType::Coup   && rulesOf(role).blocksCoup);
+    }
+
+    /**
+     * @brief A pending action slot. Blocked actions stay in place as tombstones
+     * until the next resolution; live slots with the same key are chained in
+     * registration order.
+     */
+    struct PendingAction {
+        ActionType  type;     ///< The type of action.
+        std::int8_t actor;    ///< Seat that initiated the action.
+        std::int8_t target;   ///< Target seat (kNoSeat if none).
+        std::int8_t next;     ///< Next live slot with the same key, or -1.
+        bool        blocked;  ///< Tombstone: skipped by processPending().
+    };
+
+    std::int32_t  coins[kMaxPlayers];      ///< Coin balance per seat.
+    RoleId        roles[kMaxPlayers];      ///< Role per seat.
+    std::uint8_t  abilities[kMaxPlayers];  ///< Ability bits per seat.
+    std::int8_t   order[kMaxPlayers];      ///< Active seats, in join (turn) order.
+    std::uint32_t alive;                   ///< Bit s set while seat s is in play.
+    std::uint8_t  seatCount;               ///< Seats handed out so far.
+    std::uint8_t  activeCount;             ///< Number of entries used in order[].
+    std::uint8_t  currentIndex;            ///< Index in order[] of whose turn it is.
+    std::uint8_t  pendingCount;            ///< Slots used in pending[] (including tombstones).
+    std::int32_t  pool;                    ///< Coins in the central pool.
+    PendingAction pending[kMaxPending];    ///< Pending actions, in registration order.
+
+    /// First / last live slot per (ActionType, key seat), or -1. The key is the
+    /// actor for Tax and Bribe and the target otherwise (see keyOf()).
+    std::int8_t   pendingHead[kActionTypes][kPendingKeys];
+    std::int8_t   pendingTail[kActionTypes][kPendingKeys];
+
+    /// Zobrist hash of coins, roles, alive flags, currentIndex, pool and
+    /// the pending slots; equal positions have equal hashes.
+    std::uint64_t hash;
+
+    /// Undo log for the writes below, or nullptr. Only attached for the
+    /// duration of one Game::apply(), so copies of a resting state never share it.
+    UndoJournal*  journal;
+
+    /// Receives resolutions, turn starts and removals, or nullptr. Like
+    /// journal, Game attaches it only while one of its calls runs.
+    ReplayWriter* replay;
+
+    /// Hooks for RoleId::Custom seats, or nullptr (those seats then get the
+    /// Custom row of kRoleRules). Attached by Game like replay.
+    RoleHooks*    hooks;
+
+    /**
+     * @brief Construct an empty match with a full pool and no seats.
+     */
+    GameState();
+
+    /** @name Seats */
+    ///@{
+    /**
+     * @brief Hand out the next seat and append it to the turn order.
+     * @param role      The seat's role.
+     * @param abilities Ability bits for the seat.
+     * @param coins     Starting coin balance.
+     * @return The new seat, or kNoSeat if the table is full.
+     */
+    int addSeat(RoleId role, std::uint8_t abilities, int coins);
+
+    /**
+     * @brief Replace a seat's role and ability bits.
+     */
+    void setRole(int seat, RoleId role, std::uint8_t abilities);
+
+    /**
+     * @brief Remove a seat from the turn order (successful coup).
+     * Adjusts currentIndex exactly like the original Game::removePlayer.
+     * @return InvalidPlayer if the seat is not in play.
+     */
+    ActionResult removePlayer(int seat);
+
+    /// True if seat is a valid seat that is still in play.
+    bool isAlive(int seat) const {
+        return seat >= 0 && seat < seatCount && ((alive >> seat) & 1u);
+    }
+
+    /// Seat whose turn it is, or kNoSeat if nobody is left.
+    int currentSeat() const {
+        return activeCount == 0 ? kNoSeat : order[currentIndex];
+    }
+
+    /// Seat of the last player standing, or kNoSeat while the game is active.
+    int winner() const {
+        return activeCount == 1 ? order[0] : kNoSeat;
+    }
+
+    /// True if the seat's role has every bit in mask.
+    bool can(int seat, std::uint8_t mask) const {
+        return (abilities[seat] & mask) == mask;
+    }
+
+    /// True if the seat holds ≥10 coins and therefore must coup.
+    bool mustCoup(int seat) const { return coins[seat] >= 10; }
+    ///@}
+
+    /** @name Coins */
+    ///@{
+    /// Set a seat's coin balance.
+    void setCoins(int seat, int n);
+
+    /// Add n coins to a seat (n < 0 is ignored).
+    void addCoins(int seat, int n);
+
+    /// Remove n coins from a seat; OutOfCoins if it holds fewer.
+    ActionResult removeCoins(int seat, int n);
+
+    /// Take n coins out of the pool; PoolEmpty if it holds fewer.
+    ActionResult takeFromPool(int n);
+
+    /// Return n coins to the pool (n < 0 is ignored).
+    void returnToPool(int n);
+    ///@}
+
+    /** @name Pending actions */
+    ///@{
+    /**
+     * @brief Queue an action for resolution at the next nextTurn().
+     * @return InvalidPlayer for an out-of-range seat, TableFull if no
+     *         pending slot is left.
+     */
+    ActionResult registerAction(ActionType type, int actor, int target);
+
+    /**
+     * @brief Slot in pending[] of the first live action of the given type whose
+     * actor (Tax, Bribe) or target (Arrest, Sanction, Coup) is seat, or -1. O(1).
+     */
+    int findPending(ActionType type, int seat) const;
+
+    ActionResult blockTax(int target);
+    ActionResult blockBribe(int target);
+    ActionResult blockArrest(int target);
+    ActionResult blockSanction(int target);
+    ActionResult blockCoup(int blocker, int target);
+
+    /**
+     * @brief The block*() above for type, as a player may make it: blocker's
+     * role must be able to block type (canBlock()) and the pending action
+     * must not be blocker's own, or the result is NotAllowed.
+     */
+    ActionResult block(int blocker, ActionType type, int target);
+
+    /**
+     * @brief Rebuild pendingHead, pendingTail and the next links from the
+     * first pendingCount slots (after pending[] was filled in directly, as
+     * Game::restore() does). Call rehash() afterwards.
+     */
+    void relinkPending();
+
+    /**
+     * @brief Resolve every pending action in registration order.
+     * Same outcomes as the original Game::processPending.
+     */
+    void processPending();
+
+    /**
+     * @brief Resolve pending actions, advance the turn and run the new
+     * current player's start-of-turn hook.
+     */
+    void nextTurn();
+    ///@}
+
+    /** @name Hashing */
+    ///@{
+    /**
+     * @brief Zobrist hash of the position computed from scratch.
+     * Equals hash whenever all writes went through the methods of this class.
+     */
+    std::uint64_t computeHash() const;
+
+    /// Recompute hash after fields were written directly.
+    void rehash() { hash = computeHash(); }
+    ///@}
+
+    /** @name Player actions (same checks, in the same order, as Player) */
+    ///@{
+    ActionResult gather(int seat);
+    ActionResult tax(int seat);
+    ActionResult bribe(int seat);
+    ActionResult arrest(int seat, int target);
+    ActionResult sanction(int seat, int target);
+    ActionResult coup(int seat, int target);
+
+    /**
+     * @brief Dispatch an Action to the matching method above.
+     */
+    ActionResult apply(int seat, const Action& action);
+
+    /**
+     * @brief Run an action's checks and costs and register it, without the
+     * nextTurn() that follows. apply() is declare() plus nextTurn() for
+     * everything but Bribe; in between, the action sits in its block window.
+     */
+    ActionResult declare(int seat, const Action& action);
+
+    /**
+     * @brief Fill out with every legal (ActionType, target) pair for seat.
+     * Empty unless it is seat's turn; only Coup targets when the seat must coup.
+     * Arrest, Sanction and Coup list living opponents only. Never allocates.
+     */
+    void legalActions(int seat, ActionBuffer& out) const;
+    ///@}
+
+private:
+    /// Write a field, logging its previous value when a journal is attached.
+    template <typename T, typename V>
+    void set(T& field, V value) {
+        if (journal) logWrite(&field, sizeof(T));
+        field = static_cast<T>(value);
+    }
+    void logWrite(const void* field, std::size_t size);
+
+    /// Hashed field writes: update hash with the old and new feature keys.
+    void setPool(int n);
+    void setCurrentIndex(int index);
+    void setAlive(int seat, bool on);
+    void setPending(int slot, const PendingAction& pa);
+    void setBlocked(int slot);
+
+    /// Column in pendingHead/pendingTail for a seat (kNoSeat maps to the last one).
+    static int keyOf(int seat) { return seat < 0 ? kMaxPlayers : seat; }
+
+    /// Tombstone the head slot of a (type, key) chain and unlink it.
+    void popPending(int slot);
+    void resolve(const PendingAction& pa);
+    void onArrested(int seat);
+    void onSanctioned(int seat);
+    void onStartTurn(int seat);
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value,
+              "GameState must stay trivially copyable");
@@ -9,7 +9,7 @@
  *   - blockCoup(): can pay 5 coins to cancel another player’s Coup.
  *   - onArrested(): if arrested, immediately refund 1 coin.
  */
-class General : public Role, Player {
+class General final : public Role {
 public:
     General();
     ~General() override = default;
@@ -18,7 +18,7 @@ public:
     bool canCoup() const override { return false; }
 
     /// @copydoc Role::blockCoup
-    void blockCoup(Player& target) override;
+    void blockCoup(Player& self, Player& target) override;
 
     /// @copydoc Role::onArrested
     void onArrested(Player& self) override;
@@ -29,6 +29,9 @@ public:
     /// @copydoc Role::name
     std::string name() const override { return "General"; }
 
+    /// @copydoc Role::id
+    RoleId id() const override { return RoleId::General; }
+
     /// @copydoc Role::clone
     std::unique_ptr<Role> clone() const override {
         return std::make_unique<General>(*this);
@@ -9,7 +9,7 @@
  *   - canTax(): collects 3 coins instead of the standard 2.
  *   - blockTax(): can block another player’s Tax.
  */
-class Governor : public Role,Player {
+class Governor final : public Role {
 public:
     Governor();
     ~Governor() override = default;
@@ -18,7 +18,7 @@ public:
     bool canTax() const override { return true; }
 
     /// @copydoc Role::blockTax
-    void blockTax(Player& target) override;
+    void blockTax(Player& self, Player& target) override;
 
     /// @copydoc Role::specialAction — no extra code; Game sees canTax() to allow 3-coin tax.
     void specialAction(Player& /*self*/, Player& /*target*/) override { }
@@ -26,6 +26,9 @@ public:
     /// @copydoc Role::name
     std::string name() const override { return "Governor"; }
 
+    /// @copydoc Role::id
+    RoleId id() const override { return RoleId::Governor; }
+
     /// @copydoc Role::clone
     std::unique_ptr<Role> clone() const override {
         return std::make_unique<Governor>(*this);
@@ -10,7 +10,7 @@
  *   - blockBribe(): can cancel another player’s Bribe (returning their 4 coins to the pool).
  *   - onSanctioned(): if sanctioned, the offender (sanctioner) pays +1 coin back to the pool.
  */
-class Judge : public Role,Player {
+class Judge final : public Role {
 public:
     Judge();
     ~Judge() override = default;
@@ -19,7 +19,7 @@ public:
     bool canBribe() const override { return false; }
 
     /// @copydoc Role::blockBribe
-    void blockBribe(Player& target) override;
+    void blockBribe(Player& self, Player& target) override;
 
     /// @copydoc Role::onSanctioned — understanding that Game’s blockSanction handles extra payment.
     void onSanctioned(Player& /*self*/) override;
@@ -30,6 +30,9 @@ public:
     /// @copydoc Role::name
     std::string name() const override { return "Judge"; }
 
+    /// @copydoc Role::id
+    RoleId id() const override { return RoleId::Judge; }
+
     /// @copydoc Role::clone
     std::unique_ptr<Role> clone() const override {
         return std::make_unique<Judge>(*this);
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include "Game.hpp"
+#include "Player.hpp"
+
+/**
+ * @brief One match's Game, Players and Roles in a single contiguous block.
+ *
+ * The arena allocates its block once. The Game is built at the front and
+ * every addPlayer() bump-allocates a Player behind it (plus its Role, for
+ * custom roles; built-in roles are shared flyweights), so a match costs no
+ * per-object heap allocation and its objects sit next to each other in
+ * memory. reset() ends the match: it runs the destructors,
+ * rewinds the bump pointer in O(1) and builds a fresh Game in the same
+ * memory, ready for the next match. Destroying the arena does the same and
+ * frees the block.
+ *
+ * Strings longer than the small-string buffer and the Game's name index
+ * still live on the heap.
+ */
+class MatchArena {
+public:
+    /// Default block size: the Game and a full table of six built-in roles, with room to spare.
+    static constexpr std::size_t kDefaultBytes = 16 * 1024;
+
+    /**
+     * @brief Allocate the block and build an empty Game in it.
+     * @param bytes Block size; addPlayer() throws std::bad_alloc once it is used up.
+     */
+    explicit MatchArena(std::size_t bytes = kDefaultBytes);
+    ~MatchArena();
+
+    MatchArena(const MatchArena&) = delete;
+    MatchArena& operator=(const MatchArena&) = delete;
+
+    /// The match played in this arena.
+    Game& game() { return *_game; }
+
+    /**
+     * @brief Build a Player with a new R role in the arena and add it to game().
+     * @tparam R    Concrete Role type.
+     * @param name  Player name (must be unique in the match).
+     * @param args  Arguments forwarded to R's constructor.
+     * @return The seated Player; valid until reset() or destruction.
+     */
+    template <typename R, typename... Args>
+    Player& addPlayer(const std::string& name, Args&&... args) {
+        if (_playerCount == GameState::kMaxPlayers) {
+            throw IllegalAction("Table is full, cannot add " + name);
+        }
+        const std::size_t top = _top;
+        void* playerMem = allocate(sizeof(Player), alignof(Player));
+        const std::size_t afterPlayer = _top;
+        void* roleMem = playerMem ? allocate(sizeof(R), alignof(R)) : nullptr;
+        if (!roleMem) {
+            _top = top;
+            throw std::bad_alloc();
+        }
+        R* role = new (roleMem) R(std::forward<Args>(args)...);
+        const RoleId id = role->id();
+        Player* p;
+        if (id != RoleId::Custom) {
+            // Built-in: the shared flyweight serves, the arena copy is dropped
+            role->~R();
+            _top = afterPlayer;
+            _roles[_playerCount] = nullptr;
+            p = new (playerMem) Player(name, id, _game);
+        } else {
+            _roles[_playerCount] = role;
+            p = new (playerMem) Player(name, *role, _game);
+        }
+        _players[_playerCount++] = p;
+        _game->addPlayer(p);
+        return *p;
+    }
+
+    /**
+     * @brief End the match: destroy its players, roles and game, rewind the
+     * block and start a fresh Game in it.
+     */
+    void reset();
+
+    /// Bytes in use by the current match.
+    std::size_t used() const { return _top; }
+
+    /// Size of the block.
+    std::size_t capacity() const { return _capacity; }
+
+private:
+    /**
+     * @brief Bump-allocate size bytes aligned to align.
+     * @return The memory, or nullptr if the block is full.
+     */
+    void* allocate(std::size_t size, std::size_t align);
+
+    /// Build an empty Game at the current top (throws std::bad_alloc if it does not fit).
+    void newGame();
+
+    /// Destroy everything built in the block, newest first.
+    void destroy();
+
+    std::unique_ptr<unsigned char[]> _block;     ///< The match's memory.
+    std::size_t                      _capacity;  ///< Size of _block.
+    std::size_t                      _top;       ///< Bytes handed out so far.
+    Game*                            _game;      ///< Built at the front of _block.
+    Player*                          _players[GameState::kMaxPlayers];  ///< In creation order.
+    Role*                            _roles[GameState::kMaxPlayers];    ///< Custom role of each player, or nullptr.
+    int                              _playerCount;
+};
@@ -8,7 +8,7 @@
  *   - onStartTurn(): at the beginning of their turn, if they have ≥3 coins, gain +1 coin.
  *   - onArrested(): if arrested, lose 2 coins instead of 1 (or all if <2).
  */
-class Merchant : public Role {
+class Merchant final : public Role {
 public:
     Merchant();
     ~Merchant() override = default;
@@ -33,6 +33,9 @@ public:
     /// @copydoc Role::name
     std::string name() const override { return "Merchant"; }
 
+    /// @copydoc Role::id
+    RoleId id() const override { return RoleId::Merchant; }
+
     /// @copydoc Role::clone
     std::unique_ptr<Role> clone() const override {
         return std::make_unique<Merchant>(*this);
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Action.hpp"
+#include "ActionType.hpp"
+#include "GameState.hpp"
+
+/**
+ * @brief What the players have seen of a match.
+ *
+ * Coins and roles are private; the log keeps the information that is not:
+ * starting balances, every action and block (who, what, on whom) and, for
+ * the Spy's reveal, the coin count seen by that one observer. From it,
+ * belief() derives what an observer can infer about any seat: the roles
+ * still consistent with the seat's public actions, and a coin estimate with
+ * an error bound driven by the role-dependent effects (kRoleRules) the
+ * observer could not see.
+ *
+ * Game feeds the log when one is attached (Game::setObservationLog()).
+ */
+class ObservationLog {
+public:
+    static constexpr std::uint8_t kAnyRole = (1u << static_cast<int>(RoleId::Custom)) - 1;
+
+    /**
+     * @brief One observation, in match order.
+     */
+    struct Event {
+        enum Kind : std::uint8_t {
+            Join,    ///< actor joined with coins.
+            Act,     ///< actor played type (on target).
+            Block,   ///< actor blocked a type action (on target).
+            Reveal   ///< actor (observer only) saw that target holds coins.
+        };
+
+        Kind         kind;
+        ActionType   type;
+        std::int8_t  actor;
+        std::int8_t  target;
+        std::int32_t coins;
+    };
+
+    /**
+     * @brief One observer's knowledge of one seat.
+     */
+    struct Belief {
+        std::uint8_t roleMask;  ///< Bit r set while RoleId r is still possible.
+        std::int32_t coins;     ///< Estimated balance.
+        std::int32_t slack;     ///< The balance is within coins ± slack (and ≥ 0).
+    };
+
+    /** @name Feeding the log */
+    ///@{
+    void recordJoin(int seat, int coins);
+    void recordAction(int actor, const Action& action);
+    void recordBlock(int blocker, ActionType type, int target);
+    void recordReveal(int observer, int target, int coins);
+    ///@}
+
+    /**
+     * @brief Replay the log from observer's point of view. A Block takes
+     * back the coin effects of the Tax, Arrest or Sanction it cancels.
+     * @param observer The seat whose knowledge is wanted.
+     * @param out      One Belief per seat (GameState::kMaxPlayers entries).
+     */
+    void beliefs(int observer, Belief* out) const;
+
+    /// Belief of observer about a single seat.
+    Belief belief(int observer, int seat) const;
+
+    const std::vector<Event>& events() const { return _events; }
+
+    /// Forget every event.
+    void clear() { _events.clear(); }
+
+private:
+    std::vector<Event> _events;  ///< Observations, oldest first.
+};
@@ -3,6 +3,9 @@
 #include <string>
 #include <memory>
 #include "Role.hpp"
+#include "RoleId.hpp"
+#include "Action.hpp"
+#include "ActionResult.hpp"
 #include "Game.hpp"
 #include "Exceptions.hpp"
 
@@ -11,21 +14,61 @@ class Game;
 /**
  * @brief Represents a player in the Coup-style game.
  * 
- * Each Player has a name, a coin balance, a Role (via unique_ptr), and a pointer
- * to the Game in which they participate. All Coup actions (gather, tax, bribe,
+ * Each Player has a name, a coin balance, a Role, and a pointer to the Game
+ * in which they participate. Built-in roles are shared flyweights
+ * (Role::flyweight()), so copying such a Player never allocates or clones a
+ * role; only custom roles are owned and deep-copied. All Coup actions (gather, tax, bribe,
  * arrest, sanction, coup) are implemented here, with appropriate exception checks.
+ *
+ * Once added to a Game the player is a handle on a GameState seat: the coin
+ * balance lives in the Game's state, not in the Player.
  */
 class Player {
+    friend class Game;
+
 private:
     std::string            _name;   ///< Unique player name.
-    int                    _coins;  ///< Current coin balance.
-    std::unique_ptr<Role>  _role;   ///< Owned Role object.
+    int                    _coins;  ///< Coin balance while not seated in a Game.
+    Role*                  _role;   ///< Flyweight of a built-in role, or the custom role.
+    std::unique_ptr<Role>  _owned;  ///< The custom role, when this player owns it.
+    RoleId                 _roleId; ///< _role->id(), cached; built-ins dispatch through RoleRegistry.
     Game*                  _game;   ///< Non-owned pointer to the Game instance.
+    int                    _seat;   ///< Seat in _game's state, or GameState::kNoSeat.
+
+    /**
+     * @brief RoleId of the current role (Custom for roles outside the built-ins).
+     */
+    RoleId roleId() const;
+
+    /**
+     * @brief GameState ability bits derived from the current role's canX().
+     */
+    std::uint8_t abilities() const;
+
+    /**
+     * @brief Seat of p if it plays in the same Game, else GameState::kNoSeat.
+     */
+    int seatOf(const Player& p) const;
+
+    /**
+     * @brief Throw the exception matching a rejected action's result.
+     * @param result The non-Ok result.
+     * @param action Action name used in the message ("tax", "coup", ...).
+     * @param cost   Coins the action needs (for OutOfCoins messages).
+     */
+    [[noreturn]] void raise(ActionResult result, const char* action, int cost) const;
+
+    /**
+     * @brief Take a role: a built-in one is swapped for its flyweight, a
+     * custom one becomes owned.
+     */
+    void adopt(std::unique_ptr<Role> role);
 
     /**
-     * @brief Throws NotYourTurn if this player is not the one whose turn it is.
+     * @brief Use the same role as other: the flyweight of a built-in role,
+     * or a clone of a custom one.
      */
-    void ensureMyTurn() const;
+    void copyRole(const Player& other);
 
 public:
 
@@ -37,29 +80,45 @@ public:
      */
     Player(const std::string& name, std::unique_ptr<Role> role, Game* game);
 
+    /**
+     * @brief Construct a Player with a built-in role, without allocating one.
+     * Throws IllegalAction for RoleId::Custom.
+     */
+    Player(const std::string& name, RoleId role, Game* game);
+
+    /**
+     * @brief Construct a Player with a role it does not own (e.g. one kept in
+     * a MatchArena); role must outlive the Player.
+     */
+    Player(const std::string& name, Role& role, Game* game);
+
 
     void specialAction(Player& self, Player& target);
 
 
     /**
-     * @brief Copy constructor — deep-copies the Role.
+     * @brief Copy constructor — shares a built-in role, deep-copies a custom one.
+     * The copy is not seated: it keeps a private snapshot of other's coins.
      * @param other The Player to copy from.
      */
     Player(const Player& other);
 
     /**
-     * @brief Copy assignment — deep-copies the Role.
+     * @brief Copy assignment — shares a built-in role, deep-copies a custom one.
+     * This player keeps its own seat (if any); only name, coins and role are copied.
      * @param other The Player to assign from.
      * @return Reference to this.
      */
     Player& operator=(const Player& other);
 
-    ~Player() = default;
+    virtual ~Player() = default;
 
     /** @name Accessors */
     ///@{
-    std::string name() const { return _name; }
-    int coins() const { return _coins; }
+    const std::string& name() const { return _name; }
+    /// Dense integer id (GameState seat) from Game::addPlayer, or GameState::kNoSeat.
+    int id() const { return _seat; }
+    int coins() const;
     std::string roleName() const { return _role->name(); }
     Game* game() const { return _game; }
     ///@}
@@ -108,24 +167,56 @@ public:
     void coup(Player& target);
     ///@}
 
-    /** @name Hooks & Helpers (called by Game when resolving pending actions) */
+    /** @name Blocks (each throws if the role cannot block it or nothing matching is pending) */
+    ///@{
+    /**
+     * @brief Block a pending action through this player's role, e.g.
+     * Governor blocks Tax, Spy blocks Arrest, General blocks Coup.
+     * @param target For Tax and Bribe the actor, otherwise the target of the action.
+     */
+    void blockTax(Player& target);
+    void blockBribe(Player& target);
+    void blockArrest(Player& target);
+    void blockSanction(Player& target);
+    void blockCoup(Player& target);
+    ///@}
+
+    /** @name Non-throwing actions
+     * Same rules and effects as the actions above, but a rejected action
+     * returns its reason instead of throwing, and no message is formatted.
+     * The throwing actions are wrappers around these.
+     */
+    ///@{
+    ActionResult tryGather();
+    ActionResult tryTax();
+    ActionResult tryBribe();
+    ActionResult tryArrest(Player& target);
+    ActionResult trySanction(Player& target);
+    ActionResult tryCoup(Player& target);
+
+    /// Any of the above by type, with the target given as a seat (for Arrest, Sanction, Coup).
+    ActionResult tryAction(const Action& action);
+    ///@}
+
+    /** @name Hooks & Helpers
+     * The engine applies built-in roles' effects from kRoleRules and calls
+     * these only for RoleId::Custom players; other callers may run a
+     * role's hook directly through them.
+     */
     ///@{
     /**
-     * @brief Called by Game when this player has been successfully arrested.
-     * Invokes the role’s onArrested hook (e.g. General refund, Merchant penalty).
+     * @brief Run the role’s onArrested hook (e.g. General refund, Merchant penalty).
      */
     void handleArrested();
 
     /**
-     * @brief Called by Game when this player has been successfully sanctioned.
-     * Invokes the role’s onSanctioned hook (e.g. Baron compensation).
+     * @brief Run the role’s onSanctioned hook (e.g. Baron compensation).
      */
     void handleSanctioned();
 
     virtual void onSanctioned(Player& target);
     /**
-     * @brief Called by Game at the start of this player’s turn.
-     * Invokes the role’s onStartTurn hook (e.g. Merchant’s +1 bonus).
+     * @brief Run the role’s onStartTurn hook (e.g. Merchant’s +1 bonus).
      */
     void onStartTurn();
     ///@}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "Action.hpp"
+#include "ActionType.hpp"
+#include "RoleId.hpp"
+
+struct GameState;
+
+/**
+ * @brief Binary replay format shared by the writer and the reader.
+ *
+ * A file starts with the 8-byte kMagic (the last byte is the format version)
+ * and holds any number of matches back to back. Every event is its Kind
+ * followed by its fields, all as unsigned LEB128 varints. Seats that may be
+ * GameState::kNoSeat are stored as seat + 1, so "none" encodes as 0; signed
+ * coin deltas are zigzag-encoded.
+ *
+ * Input events (Begin … Pool) are what a re-simulation feeds back into a
+ * Game; derived events (Resolve, Turn, Removed) record what the rules made
+ * of them, for auditing and training; End carries the result to check
+ * against.
+ */
+namespace Replay {
+
+constexpr char kMagic[8] = {'C', 'O', 'U', 'P', 'R', 'P', 'L', 1};
+
+enum Kind : std::uint8_t {
+    // Input
+    Begin = 1,  ///< match id
+    Join,       ///< seat, role, coins
+    Act,        ///< seat, type, target+1 (a successful Player action)
+    Apply,      ///< seat, type, target+1 (a successful Game::apply, which undo() can take back)
+    Register,   ///< type, actor+1, target+1 (Game::register*)
+    Block,      ///< type, blocker+1, target+1
+    NextTurn,   ///< (Game::nextTurn)
+    Remove,     ///< seat (Game::removePlayer)
+    Undo,       ///< (Game::undo)
+    Coins,      ///< seat, zigzag delta (Player::addCoins / removeCoins on a seated player)
+    Pool,       ///< zigzag delta (Game::takeFromPool / returnToPool)
+    // Derived
+    Resolve,    ///< type, actor+1, target+1, blocked
+    Turn,       ///< seat whose turn starts
+    Removed,    ///< seat taken out of play
+    // Result
+    End         ///< winner+1, pool, seat count, then coins of every seat
+};
+
+} // namespace Replay
+
+/**
+ * @brief Append-only, buffered writer of the replay format.
+ *
+ * Attached to a Game (Game::setReplayWriter()), it receives every input and
+ * derived event of the match; beginMatch() and endMatch() frame each match.
+ * Events are encoded into a 64 KiB buffer that is written out when full, on
+ * flush() and on destruction, so logging costs a few byte stores per event.
+ */
+class ReplayWriter {
+public:
+    /**
+     * @brief Open path for appending; the header is written if the file is new.
+     * Throws std::runtime_error if the file cannot be opened.
+     */
+    explicit ReplayWriter(const std::string& path);
+
+    /// Flush and close the file.
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    /** @name Framing */
+    ///@{
+    void beginMatch(std::uint64_t id);
+    /// Record the result: winner (or none), pool and every seat's coins.
+    void endMatch(const GameState& state);
+    ///@}
+
+    /** @name Input events */
+    ///@{
+    void join(int seat, RoleId role, int coins);
+    /// A Player action (Act) or, if undoable, a Game::apply (Apply).
+    void act(int seat, const Action& action, bool undoable);
+    void registerAction(ActionType type, int actor, int target);
+    void block(ActionType type, int blocker, int target);
+    void nextTurn();
+    void remove(int seat);
+    void undo();
+    void coins(int seat, int delta);
+    void pool(int delta);
+    ///@}
+
+    /** @name Derived events (written by GameState) */
+    ///@{
+    void resolve(ActionType type, int actor, int target, bool blocked);
+    void turn(int seat);
+    void removed(int seat);
+    ///@}
+
+    /// Write the buffer out. Throws std::runtime_error on a write error.
+    void flush();
+
+    /// Bytes encoded so far by this writer (flushed or not).
+    std::uint64_t bytesWritten() const { return _written + _used; }
+
+private:
+    static constexpr std::size_t kBufferSize = 64 * 1024;
+
+    /// Append one varint; flushes first if the buffer could overflow.
+    void put(std::uint64_t v);
+
+    std::FILE*    _file;
+    std::size_t   _used;                ///< Bytes in _buffer.
+    std::uint64_t _written;             ///< Bytes already handed to _file.
+    unsigned char _buffer[kBufferSize];
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "ActionType.hpp"
+#include "GameState.hpp"
+#include "MatchArena.hpp"
+#include "ReplayLog.hpp"
+#include "RoleId.hpp"
+
+namespace Replay {
+
+/**
+ * @brief One decoded replay event. Which fields are set depends on kind
+ * (see Replay::Kind); seats that were stored as "none" read back as
+ * GameState::kNoSeat.
+ */
+struct Event {
+    Kind          kind;
+    int           seat;       ///< Seat, actor, blocker or (End) winner.
+    int           target;     ///< Target seat of Act, Apply, Register, Block, Resolve.
+    ActionType    type;       ///< Act, Apply, Register, Block, Resolve.
+    RoleId        role;       ///< Join.
+    int           value;      ///< Join coins, Coins / Pool delta, Resolve blocked flag, End pool.
+    std::uint64_t id;         ///< Begin.
+    int           seatCount;  ///< End.
+    int           coins[GameState::kMaxPlayers];  ///< End: coins of each seat.
+};
+
+/**
+ * @brief Outcome of re-simulating one match.
+ */
+struct Verdict {
+    std::uint64_t match;   ///< Id from the match's Begin event.
+    std::uint64_t events;  ///< Events read for the match, Begin and End included.
+    bool          ok;      ///< Every input replayed and the result matched End.
+    std::string   reason;  ///< What diverged first (empty when ok).
+};
+
+} // namespace Replay
+
+/**
+ * @brief Read-only, memory-mapped view of a replay file.
+ *
+ * The file is mapped once and events are decoded straight from the mapping
+ * as next() walks it, so reading copies nothing and allocates nothing. The
+ * header is checked on construction.
+ */
+class ReplayReader {
+public:
+    /**
+     * @brief Map path and check its header.
+     * Throws std::runtime_error if the file cannot be mapped or is not a replay.
+     */
+    explicit ReplayReader(const std::string& path);
+
+    /// Unmap the file.
+    ~ReplayReader();
+
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+
+    /**
+     * @brief Decode the next event into e.
+     * @return False at the end of the file.
+     * Throws std::runtime_error on a truncated or unknown event.
+     */
+    bool next(Replay::Event& e);
+
+    /// Go back to the first event.
+    void rewind() { _pos = sizeof(Replay::kMagic); }
+
+    /// Byte offset of the next event.
+    std::size_t offset() const { return _pos; }
+
+    /// Size of the file in bytes.
+    std::size_t size() const { return _size; }
+
+private:
+    /// Decode one varint (throws std::runtime_error past the end).
+    std::uint64_t get();
+
+    /// Decode a seat stored as seat + 1.
+    int getSeat() { return static_cast<int>(get()) - 1; }
+
+    const unsigned char* _data;
+    std::size_t          _size;
+    std::size_t          _pos;
+};
+
+/**
+ * @brief Replays recorded matches into a fresh Game and checks the result.
+ *
+ * Each match is rebuilt in a MatchArena that is reset between matches. Input
+ * events go through the public Game and Player calls that produced them, so
+ * the current rules (not the recorded ones) decide every outcome; derived
+ * events are skipped. At End the winner, the pool and every seat's coins are
+ * compared with the recorded values. A rejected or throwing input ends the
+ * check for that match, and the rest of it is skipped up to its End.
+ *
+ * Matches with custom roles cannot be rebuilt and are reported as failed.
+ */
+class Resimulator {
+public:
+    /**
+     * @brief Replay the next match from reader into verdict.
+     * @return False if the reader has no further match.
+     * Throws std::runtime_error if the file is corrupt or ends mid-match.
+     */
+    bool run(ReplayReader& reader, Replay::Verdict& verdict);
+
+private:
+    /**
+     * @brief Feed one input event to the game.
+     * @return Empty on success, otherwise why the event could not be replayed.
+     */
+    std::string replay(const Replay::Event& e);
+
+    /// Compare the game with an End event; empty if it matches.
+    std::string check(const Replay::Event& e);
+
+    MatchArena _arena;
+};
@@ -4,6 +4,7 @@
 #include <memory>
 #include "Exceptions.hpp"
 #include "ActionType.hpp"
+#include "RoleId.hpp"
 
 class Player;   // forward declaration
 
@@ -35,14 +36,17 @@ public:
     virtual bool canCoup()      const { return false; }   ///< Anyone can Coup if ≥7 coins.
     ///@}
 
-    /** @name Blocking powers (by default, illegal) */
+    /** @name Blocking powers (by default, illegal)
+     * self is the blocking Player (the owner of this role), target the
+     * player whose action is blocked.
+     */
     ///@{
-    virtual void blockGather(Player& /*target*/)   { throw IllegalAction("Cannot block gather"); }
-    virtual void blockTax(Player& /*target*/)      { throw IllegalAction("Cannot block tax"); }
-    virtual void blockBribe(Player& /*target*/)    { throw IllegalAction("Cannot block bribe"); }
-    virtual void blockArrest(Player& /*target*/)   { throw IllegalAction("Cannot block arrest"); }
-    virtual void blockSanction(Player& /*target*/) { throw IllegalAction("Cannot block sanction"); }
-    virtual void blockCoup(Player& /*target*/)     { throw IllegalAction("Cannot block coup"); }
+    virtual void blockGather(Player& /*self*/, Player& /*target*/)   { throw IllegalAction("Cannot block gather"); }
+    virtual void blockTax(Player& /*self*/, Player& /*target*/)      { throw IllegalAction("Cannot block tax"); }
+    virtual void blockBribe(Player& /*self*/, Player& /*target*/)    { throw IllegalAction("Cannot block bribe"); }
+    virtual void blockArrest(Player& /*self*/, Player& /*target*/)   { throw IllegalAction("Cannot block arrest"); }
+    virtual void blockSanction(Player& /*self*/, Player& /*target*/) { throw IllegalAction("Cannot block sanction"); }
+    virtual void blockCoup(Player& /*self*/, Player& /*target*/)     { throw IllegalAction("Cannot block coup"); }
     ///@}
 
     /** @name Hooks called when certain actions resolve (default no-op) */
@@ -78,4 +82,20 @@ public:
      * @return The name of the role.
      */
     virtual std::string name() const = 0;
+
+    /**
+     * @brief Returns the role's id; GameState looks up its rules by id.
+     * Roles outside the six built-ins keep the default, RoleId::Custom.
+     * @return The id of the role.
+     */
+    virtual RoleId id() const { return RoleId::Custom; }
+
+    /**
+     * @brief The shared instance of a built-in role.
+     * Built-in roles hold no per-player data, so all Players with the same
+     * built-in role use this one instance instead of a clone each.
+     * @param id The role.
+     * @return The instance (lives for the whole program), or nullptr for RoleId::Custom.
+     */
+    static Role* flyweight(RoleId id);
 };
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Small integer identifier for each built-in role.
+ * Roles outside the six built-ins (e.g. test or extension roles) map to Custom.
+ */
+enum class RoleId : std::uint8_t {
+    Governor,
+    Spy,
+    Baron,
+    General,
+    Judge,
+    Merchant,
+    Custom
+};
+
+/**
+ * @brief Display name of a role id ("Custom" for roles outside the built-ins).
+ */
+inline const char* roleIdName(RoleId id) {
+    static const char* const kNames[] = {
+        "Governor", "Spy", "Baron", "General", "Judge", "Merchant", "Custom"
+    };
+    return kNames[static_cast<int>(id)];
+}
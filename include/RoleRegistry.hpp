@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include "RoleId.hpp"
+#include "Governor.hpp"
+#include "Spy.hpp"
+#include "Baron.hpp"
+#include "General.hpp"
+#include "Judge.hpp"
+#include "Merchant.hpp"
+
+/**
+ * @brief Compile-time registry of the built-in roles.
+ *
+ * BuiltinRoles lists the six role classes in RoleId order. From it come a
+ * std::variant holding any built-in role by value (RoleVariant) and
+ * visitRole(), which calls a generic callable with the concrete role for a
+ * RoleId. The role classes are final, so calls made through the concrete
+ * type are resolved statically and can be inlined; nothing goes through the
+ * Role vtable. Extension roles keep using the Role base class and
+ * RoleId::Custom, which the registry does not cover.
+ *
+ * Player uses it for abilities() and for its hook methods. The rules
+ * engine does not: GameState resolves built-in roles from kRoleRules, so
+ * the hot path has no per-role calls to devirtualize in the first place.
+ */
+template <typename... Rs>
+struct RoleList {
+    static constexpr std::size_t size = sizeof...(Rs);
+};
+
+using BuiltinRoles = RoleList<Governor, Spy, Baron, General, Judge, Merchant>;
+
+namespace detail {
+
+template <typename List>
+struct VariantOf;
+
+template <typename... Rs>
+struct VariantOf<RoleList<Rs...>> {
+    using type = std::variant<Rs...>;
+};
+
+template <typename List, std::size_t I>
+struct RoleAt;
+
+template <typename R, typename... Rs>
+struct RoleAt<RoleList<R, Rs...>, 0> {
+    using type = R;
+};
+
+template <typename R, typename... Rs, std::size_t I>
+struct RoleAt<RoleList<R, Rs...>, I> {
+    using type = typename RoleAt<RoleList<Rs...>, I - 1>::type;
+};
+
+template <typename R>
+R& instance() {
+    static R role;
+    return role;
+}
+
+// A chain of comparisons on a constant index, which the compiler folds into
+// one switch with every call inlined.
+template <std::size_t I, typename F>
+decltype(auto) visitRole(RoleId id, F&& f) {
+    if constexpr (I + 1 == BuiltinRoles::size) {
+        return f(instance<typename RoleAt<BuiltinRoles, I>::type>());
+    } else {
+        if (static_cast<std::size_t>(id) == I) {
+            return f(instance<typename RoleAt<BuiltinRoles, I>::type>());
+        }
+        return visitRole<I + 1>(id, std::forward<F>(f));
+    }
+}
+
+} // namespace detail
+
+/// Built-in role at RoleId index I.
+template <std::size_t I>
+using RoleAt = typename detail::RoleAt<BuiltinRoles, I>::type;
+
+/// Any built-in role, held by value.
+using RoleVariant = typename detail::VariantOf<BuiltinRoles>::type;
+
+/**
+ * @brief A RoleVariant holding the role with the given id.
+ * @param id A built-in id (not RoleId::Custom).
+ */
+RoleVariant makeRoleVariant(RoleId id);
+
+/**
+ * @brief Call f with the shared instance (Role::flyweight()) of the
+ * built-in role id, as its concrete type. Every alternative must return
+ * the same type.
+ * @param id A built-in id (not RoleId::Custom).
+ * @param f  Generic callable, e.g. [](auto& role) { return role.canTax(); }.
+ */
+template <typename F>
+decltype(auto) visitRole(RoleId id, F&& f) {
+    return detail::visitRole<0>(id, std::forward<F>(f));
+}
+
+/**
+ * @brief GameState ability bits of a role, from its canX() overrides.
+ */
+template <typename R>
+std::uint8_t abilityBits(const R& r) {
+    std::uint8_t bits = 0;
+    if (r.canGather())   bits |= GameState::CanGather;
+    if (r.canTax())      bits |= GameState::CanTax;
+    if (r.canBribe())    bits |= GameState::CanBribe;
+    if (r.canArrest())   bits |= GameState::CanArrest;
+    if (r.canSanction()) bits |= GameState::CanSanction;
+    if (r.canCoup())     bits |= GameState::CanCoup;
+    return bits;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "RoleId.hpp"
+
+/**
+ * @brief Rule parameters of one role, as used by GameState when resolving
+ * actions. Mirrors the behavior coded in the role classes.
+ */
+struct RoleRules {
+    bool canTax;               ///< Role::canTax()
+    bool canBribe;             ///< Role::canBribe()
+    bool canArrest;            ///< Role::canArrest()
+    bool canSanction;          ///< Role::canSanction()
+    bool blocksTax;            ///< Overrides Role::blockTax (Governor).
+    bool blocksBribe;          ///< Overrides Role::blockBribe (Judge).
+    bool blocksArrest;         ///< Overrides Role::blockArrest (Spy).
+    bool blocksCoup;           ///< Overrides Role::blockCoup (General).
+    int  taxAmount;            ///< Coins from an unblocked Tax.
+    int  arrestLoss;           ///< Coins stolen from this role by an Arrest.
+    int  arrestPenalty;        ///< Extra coins lost after being arrested (onArrested).
+    int  arrestRefund;         ///< Coins received after being arrested (onArrested).
+    int  sanctionCompensation; ///< Coins received after being sanctioned (onSanctioned).
+    int  startTurnThreshold;   ///< Minimum coins for the start-of-turn bonus.
+    int  startTurnBonus;       ///< Coins received at the start of the turn (onStartTurn).
+};
+
+/**
+ * @brief Rule table indexed by RoleId.
+ */
+constexpr RoleRules kRoleRules[] = {
+    //            tax    bribe  arrest sanct. | blocks: tax  bribe  arrest coup  | taxAmt loss penalty refund comp. thresh bonus
+    /* Governor */ {true,  false, false, false,  true,  false, false, false, 3,     1,   0,      0,     0,    0,     0},
+    /* Spy      */ {false, false, false, false,  false, false, true,  false, 2,     1,   0,      0,     0,    0,     0},
+    /* Baron    */ {false, false, false, false,  false, false, false, false, 2,     1,   0,      0,     1,    0,     0},
+    /* General  */ {false, false, false, false,  false, false, false, true,  2,     1,   0,      1,     0,    0,     0},
+    /* Judge    */ {false, false, false, false,  false, true,  false, false, 2,     1,   0,      0,     0,    0,     0},
+    /* Merchant */ {false, false, false, false,  false, false, false, false, 2,     2,   2,      0,     0,    3,     1},
+    /* Custom   */ {false, false, false, false,  false, false, false, false, 2,     1,   0,      0,     0,    0,     0},
+};
+
+static_assert(sizeof(kRoleRules) / sizeof(kRoleRules[0]) == static_cast<int>(RoleId::Custom) + 1,
+              "kRoleRules needs one row per RoleId");
+
+/**
+ * @brief Rule parameters for a role id.
+ */
+constexpr const RoleRules& rulesOf(RoleId id) {
+    return kRoleRules[static_cast<int>(id)];
+}
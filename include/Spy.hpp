@@ -10,7 +10,7 @@
  *   - specialAction(): “Look at” another player’s coin count (prints to stdout).
  *   - blockArrest(): can block another player’s Arrest.
  */
-class Spy : public Role,Player {
+class Spy final : public Role {
 public:
     Spy();
     ~Spy() override = default;
@@ -19,10 +19,10 @@ public:
     bool canArrest() const override { return false; }
 
     /// @copydoc Role::blockArrest
-    void blockArrest(Player& target) override;
+    void blockArrest(Player& self, Player& target) override;
 
     /**
-     * @brief Reveal target’s coin count to stdout.
+     * @brief Reveal target’s coin count to stdout and to the game’s observation log.
      * @param self   The Spy performing the action.
      * @param target The Player whose coins are revealed.
      */
@@ -31,6 +31,9 @@ public:
     /// @copydoc Role::name
     std::string name() const override { return "Spy"; }
 
+    /// @copydoc Role::id
+    RoleId id() const override { return RoleId::Spy; }
+
     /// @copydoc Role::clone
     std::unique_ptr<Role> clone() const override {
         return std::make_unique<Spy>(*this);
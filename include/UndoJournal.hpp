@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Write log that lets a GameState step back over applied moves.
+ *
+ * While attached to a GameState, every field the rules engine writes (coins,
+ * pool, currentIndex, turn order, alive mask, pending slots and their index)
+ * is recorded as (offset, size, previous value) before it changes. mark()
+ * opens a move; rollback() restores the recorded bytes of the most recent
+ * move in reverse order. Storage grows to the deepest line searched and is
+ * then reused, so make/unmake in a search loop does not allocate.
+ */
+class UndoJournal {
+public:
+    /**
+     * @brief One recorded field write.
+     */
+    struct Entry {
+        std::uint16_t offset;  ///< Byte offset of the field in the state.
+        std::uint8_t  size;    ///< Field size in bytes (at most 8).
+        std::uint64_t old;     ///< Previous contents of the field.
+    };
+
+    /**
+     * @brief Record the current contents of a field that is about to change.
+     * @param base  Start of the journaled object.
+     * @param field Start of the field inside base.
+     * @param size  Field size in bytes (at most 8).
+     */
+    void record(const void* base, const void* field, std::size_t size);
+
+    /**
+     * @brief Start a new move; later records belong to it.
+     */
+    void mark();
+
+    /**
+     * @brief Restore every field written since the last mark() and drop the mark.
+     * @param base The journaled object (must be the one passed to record()).
+     * @return False if there is no move to undo.
+     */
+    bool rollback(void* base);
+
+    /// Number of moves that can be undone.
+    std::size_t depth() const { return _marks.size(); }
+
+    /// Forget every recorded move.
+    void clear();
+
+private:
+    std::vector<Entry>       _entries;  ///< Recorded writes, oldest first.
+    std::vector<std::size_t> _marks;    ///< Start of each move in _entries.
+};
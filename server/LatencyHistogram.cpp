@@ -0,0 +1,33 @@
+#include "LatencyHistogram.hpp"
+
+LatencyHistogram::LatencyHistogram() : _total(0), _max(0) {
+    for (auto& c : _counts) c.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::upperBound(int b) {
+    if (b < (1 << kSubBits)) return static_cast<std::uint64_t>(b);
+    int e = (b >> kSubBits) + kSubBits - 1;
+    std::uint64_t sub = static_cast<std::uint64_t>(b & ((1 << kSubBits) - 1));
+    std::uint64_t width = std::uint64_t{1} << (e - kSubBits);
+    return (((std::uint64_t{1} << kSubBits) + sub) << (e - kSubBits)) + width - 1;
+}
+
+//
+// Walk the buckets until the running count reaches q of the total.
+//
+std::uint64_t LatencyHistogram::percentile(double q) const {
+    std::uint64_t total = count();
+    if (total == 0) return 0;
+    std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(total));
+    if (rank == 0) rank = 1;
+    std::uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        seen += _counts[b].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            std::uint64_t ub = upperBound(b);
+            std::uint64_t m = max();
+            return ub < m ? ub : m;
+        }
+    }
+    return max();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Log-linear histogram of latencies in nanoseconds.
+ *
+ * Each power of two is split into eight buckets, so a percentile is
+ * reported with at most 12.5% error, over the full 64-bit range, in 4 KiB.
+ * One thread records; any thread may read at the same time. The counters
+ * are relaxed atomics, so readers see a consistent-enough view without
+ * the writer ever taking a lock.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    /// Add one sample. Single writer.
+    void record(std::uint64_t ns) {
+        _counts[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        _total.fetch_add(1, std::memory_order_relaxed);
+        if (ns > _max.load(std::memory_order_relaxed)) _max.store(ns, std::memory_order_relaxed);
+    }
+
+    /// Number of samples.
+    std::uint64_t count() const { return _total.load(std::memory_order_relaxed); }
+
+    /// Largest sample.
+    std::uint64_t max() const { return _max.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Upper bound of the bucket holding the q-quantile (0 < q ≤ 1),
+     * capped at max(); 0 if there are no samples.
+     */
+    std::uint64_t percentile(double q) const;
+
+private:
+    static constexpr int kSubBits = 3;                  ///< 8 buckets per power of two.
+    static constexpr int kBuckets = 64 << kSubBits;
+
+    static int bucketOf(std::uint64_t ns) {
+        if (ns < (1u << kSubBits)) return static_cast<int>(ns);
+        int e = 63 - __builtin_clzll(ns);
+        int sub = static_cast<int>(ns >> (e - kSubBits)) & ((1 << kSubBits) - 1);
+        return ((e - kSubBits + 1) << kSubBits) + sub;
+    }
+
+    /// Largest value that falls in bucket b.
+    static std::uint64_t upperBound(int b);
+
+    std::atomic<std::uint64_t> _counts[kBuckets];
+    std::atomic<std::uint64_t> _total;
+    std::atomic<std::uint64_t> _max;
+};
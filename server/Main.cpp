@@ -0,0 +1,67 @@
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <string>
+#include <pthread.h>
+
+#include "MatchServer.hpp"
+
+/**
+ * @brief Runs a MatchServer until SIGINT or SIGTERM.
+ *
+ * Usage:
+ *   coup_server [-j shards] [-i seconds] [-w ms] socket-path
+ *
+ * Every -i seconds (default 10; 0 turns it off) and on exit, the turn
+ * latency of each shard is printed. -w sets the reaction window a declared
+ * action stays open to blocks (default 2000 ms). Try it with a scripted client:
+ *   printf 'NEW Governor Spy\nACT 0 0 Gather\nSTATE 0\n' | socat - UNIX-CONNECT:socket-path
+ */
+int main(int argc, char** argv) {
+    int shards = 0;
+    int interval = 10;
+    int windowMs = 2000;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-j" && hasValue)      shards = std::atoi(argv[++i]);
+        else if (arg == "-i" && hasValue) interval = std::atoi(argv[++i]);
+        else if (arg == "-w" && hasValue) windowMs = std::atoi(argv[++i]);
+        else if (arg[0] != '-' && !path)  path = argv[i];
+        else                              path = nullptr, i = argc;
+    }
+    if (!path) {
+        std::fprintf(stderr, "usage: coup_server [-j shards] [-i seconds] [-w ms] socket-path\n");
+        return 1;
+    }
+
+    // Block the stop signals before the shards start so only sigtimedwait sees them
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    try {
+        MatchServer server(path, shards, windowMs);
+        server.start();
+        std::printf("listening on %s with %d shards\n", path, server.shards());
+        std::fflush(stdout);
+        timespec wait{interval > 0 ? interval : 3600, 0};
+        while (sigtimedwait(&stopSignals, nullptr, &wait) < 0) {
+            if (interval > 0) {
+                std::printf("%s\n", server.statsLine().c_str());
+                std::fflush(stdout);
+            }
+        }
+        std::printf("%s\n", server.statsLine().c_str());
+        server.stop();
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "coup_server: %s\n", ex.what());
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,777 @@
+#include "MatchServer.hpp"
+#include "LatencyHistogram.hpp"
+#include "TimerWheel.hpp"
+#include "../include/MatchArena.hpp"
+#include "../include/RoleRegistry.hpp"
+#include "../include/Player.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Arena block of one hosted match: the Game and a full table of players.
+constexpr std::size_t kMatchBytes = sizeof(Game) + alignof(Game)
+                                  + MatchServer::kMaxTable * (sizeof(Player) + alignof(Player));
+
+// Longest command line a client may send.
+constexpr std::size_t kMaxLine = 4096;
+
+// Most words in a command line.
+constexpr int kMaxArgs = MatchServer::kMaxTable + 2;
+
+const std::string kSeatNames[MatchServer::kMaxTable] = {"p0", "p1", "p2", "p3", "p4", "p5"};
+
+const char* const kActionNames[] = {"Gather", "Tax", "Bribe", "Arrest", "Sanction", "Coup"};
+
+[[noreturn]] void fail(const char* what) {
+    throw std::runtime_error(std::string(what) + ": " + std::strerror(errno));
+}
+
+bool parseRole(std::string_view s, RoleId& out) {
+    for (int i = 0; i < static_cast<int>(RoleId::Custom); ++i) {
+        if (s == roleIdName(static_cast<RoleId>(i))) {
+            out = static_cast<RoleId>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseAction(std::string_view s, ActionType& out) {
+    for (int i = 0; i < GameState::kActionTypes; ++i) {
+        if (s == kActionNames[i]) {
+            out = static_cast<ActionType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+bool parseNumber(std::string_view s, T& out) {
+    auto r = std::from_chars(s.data(), s.data() + s.size(), out);
+    return r.ec == std::errc() && r.ptr == s.data() + s.size();
+}
+
+void appendNumber(std::string& out, std::uint64_t v) {
+    char buf[24];
+    auto r = std::to_chars(buf, buf + sizeof(buf), v);
+    out.append(buf, r.ptr);
+}
+
+void appendSeat(std::string& out, int seat) {
+    if (seat == GameState::kNoSeat) out += '-';
+    else appendNumber(out, static_cast<std::uint64_t>(seat));
+}
+
+// "<match> <seat> <Action> [<target>]" after the command word.
+bool parseMove(const std::string_view* args, int n, int& seat, ActionType& type, int& target) {
+    target = GameState::kNoSeat;
+    return parseNumber(args[2], seat) && parseAction(args[3], type)
+        && (n < 5 || parseNumber(args[4], target));
+}
+
+void appendError(std::string& out, ActionResult r) {
+    out += "ERR ";
+    out += actionResultName(r);
+    out += '\n';
+}
+
+// Split a line into its words; -1 if there are more than kMaxArgs.
+int splitArgs(std::string_view line, std::string_view* args) {
+    int n = 0;
+    for (std::size_t pos = 0; pos < line.size();) {
+        std::size_t end = line.find(' ', pos);
+        if (end == std::string_view::npos) end = line.size();
+        if (end > pos) {
+            if (n == kMaxArgs) return -1;
+            args[n++] = line.substr(pos, end - pos);
+        }
+        pos = end + 1;
+    }
+    return n;
+}
+
+// A command line handed to the shard that owns its match; the same node
+// then carries the reply back.
+struct Mail {
+    Mail*         next = nullptr;
+    int           from = 0;       ///< Shard of the client connection.
+    int           fd = -1;        ///< The connection there...
+    std::uint64_t serial = 0;     ///< ...and its serial, in case fd was reused.
+    bool          reply = false;
+    std::string   text;           ///< The command line, then the reply lines.
+};
+
+// Lock-free mailbox with many senders and one reader. Senders push onto
+// a stack; the reader takes the whole stack and reverses it, so mail
+// from one sender comes out in the order it was sent.
+class Mailbox {
+public:
+    Mailbox() = default;
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    ~Mailbox() {
+        for (Mail* m = take(); m;) {
+            Mail* next = m->next;
+            delete m;
+            m = next;
+        }
+    }
+
+    void push(Mail* m) {
+        m->next = _head.load(std::memory_order_relaxed);
+        while (!_head.compare_exchange_weak(m->next, m, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// Everything sent so far, oldest first.
+    Mail* take() {
+        Mail* m = _head.exchange(nullptr, std::memory_order_acquire);
+        Mail* fifo = nullptr;
+        while (m) {
+            Mail* next = m->next;
+            m->next = fifo;
+            fifo = m;
+            m = next;
+        }
+        return fifo;
+    }
+
+private:
+    std::atomic<Mail*> _head{nullptr};
+};
+
+} // namespace
+
+//
+// One worker: an epoll loop over its connections, the listening socket
+// (shared, exclusive wakeups) and an eventfd that other shards and stop()
+// signal, which sleeps no longer than the next reaction window deadline.
+//
+struct MatchServer::Shard {
+    struct Connection {
+        std::uint64_t serial = 0;                   ///< Tells a reused fd apart in mail replies.
+        std::string   in;                           ///< Bytes received, not yet answered.
+        std::string   out;                          ///< Replies not yet written.
+        std::uint32_t events = EPOLLIN | EPOLLRDHUP; ///< Registered epoll events.
+        bool          waiting = false;              ///< A command is out at another shard.
+        bool          eof = false;                  ///< The peer sent everything it will.
+        bool          quitting = false;             ///< Answer no more; close once out is drained.
+    };
+
+    struct Match {
+        std::unique_ptr<MatchArena> arena;
+        TimerWheel::Handle          window = TimerWheel::kNoTimer;  ///< Open reaction window.
+    };
+
+    Shard(const MatchServer& server, int index)
+        : server(server), index(index), epoch(std::chrono::steady_clock::now()) {}
+
+    const MatchServer&                                             server;
+    const int                                                      index;
+    int                                                            epollFd = -1;
+    int                                                            wakeFd = -1;
+    std::thread                                                    thread;
+    std::unordered_map<int, Connection>                            connections;
+    std::unordered_map<std::uint64_t, Match>                       matches;
+    std::uint64_t                                                  nextMatch = 0;
+    std::uint64_t                                                  nextSerial = 0;
+    Mailbox                                                        mailbox;   ///< Commands for this shard's matches, replies to its connections.
+    std::atomic<bool>                                              stopping{false};
+    const std::chrono::steady_clock::time_point                    epoch;
+    TimerWheel                                                     windows;   ///< Ticks are ms since epoch.
+    LatencyHistogram                                               latency;
+    std::atomic<std::uint64_t>                                     liveMatches{0};
+    std::atomic<std::uint64_t>                                     openWindows{0};
+
+    void run(int listenFd);
+    void acceptAll(int listenFd);
+    void onReadable(int fd);
+    void serve(int fd, Connection& c);
+    void flush(int fd, Connection& c);
+    void close(int fd);
+
+    void send(int shard, Mail* mail);
+    void onMail();
+
+    std::uint64_t tick() const;
+    void expire(std::uint64_t id);
+    void openWindow(std::string_view id, Match& match, std::string& out);
+    void closeWindow(Match& match);
+
+    void handle(std::string_view line, int fd, Connection& c);
+    int ownerOf(const std::string_view* args, int n) const;
+    void execute(const std::string_view* args, int n, std::string& out);
+    Match* find(std::string_view id, std::string& out);
+    void cmdNew(const std::string_view* args, int n, std::string& out);
+    void cmdAct(const std::string_view* args, int n, std::string& out);
+    void cmdBlock(const std::string_view* args, int n, std::string& out);
+    void cmdState(const std::string_view* args, int n, std::string& out);
+};
+
+void MatchServer::Shard::run(int listenFd) {
+    epoll_event events[64];
+    for (;;) {
+        int timeout = -1;
+        if (windows.size() > 0) {
+            std::uint64_t now = tick();
+            std::uint64_t deadline = windows.nextDeadline();
+            timeout = deadline <= now ? 0 : static_cast<int>(std::min<std::uint64_t>(deadline - now, 60000));
+        }
+        int n = ::epoll_wait(epollFd, events, 64, timeout);
+        // Close due windows first; this also brings the wheel's clock up to
+        // date for the windows the commands below open.
+        if (windows.advance(tick(), [this](std::uint64_t id) { expire(id); }) > 0) {
+            openWindows.store(windows.size(), std::memory_order_relaxed);
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        bool stop = false;
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                onMail();
+                stop = stopping.load(std::memory_order_acquire);
+            } else if (fd == listenFd) {
+                acceptAll(listenFd);
+            } else {
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP)) onReadable(fd);
+                auto it = connections.find(fd);
+                if (it != connections.end() && (events[i].events & EPOLLOUT)) flush(fd, it->second);
+            }
+        }
+        if (stop) break;
+    }
+    while (!connections.empty()) close(connections.begin()->first);
+    matches.clear();
+    liveMatches.store(0, std::memory_order_relaxed);
+}
+
+void MatchServer::Shard::acceptAll(int listenFd) {
+    for (;;) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;   // EAGAIN: another shard took it, or none left
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            ::close(fd);
+            continue;
+        }
+        Connection c;
+        c.serial = nextSerial++;
+        connections.emplace(fd, std::move(c));
+    }
+}
+
+//
+// Read everything available, answer the complete lines, then write the
+// replies out.
+//
+void MatchServer::Shard::onReadable(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) return;
+    Connection& c = it->second;
+    char buf[16384];
+    bool eof = false;
+    for (;;) {
+        ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n > 0) {
+            c.in.append(buf, static_cast<std::size_t>(n));
+            continue;
+        }
+        if (n == 0) eof = true;
+        else if (errno == EINTR) continue;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK) eof = true;
+        break;
+    }
+
+    if (eof) c.eof = true;
+    serve(fd, c);
+    std::size_t last = c.in.rfind('\n');
+    if (c.in.size() - (last == std::string::npos ? 0 : last + 1) > kMaxLine) {
+        close(fd);
+        return;
+    }
+    flush(fd, c);
+}
+
+//
+// Answer complete lines in order. A command sent to another shard holds
+// back the lines after it until its reply is in, so replies keep the
+// order of the commands.
+//
+void MatchServer::Shard::serve(int fd, Connection& c) {
+    std::size_t start = 0;
+    for (std::size_t nl; !c.quitting && !c.waiting && (nl = c.in.find('\n', start)) != std::string::npos;
+         start = nl + 1) {
+        std::size_t end = nl > start && c.in[nl - 1] == '\r' ? nl - 1 : nl;
+        handle(std::string_view(c.in.data() + start, end - start), fd, c);
+    }
+    c.in.erase(0, start);
+    if (c.eof && !c.waiting) c.quitting = true;
+}
+
+void MatchServer::Shard::flush(int fd, Connection& c) {
+    std::size_t sent = 0;
+    while (sent < c.out.size()) {
+        ssize_t n = ::send(fd, c.out.data() + sent, c.out.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<std::size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            close(fd);
+            return;
+        }
+    }
+    c.out.erase(0, sent);
+    if (c.out.empty() && c.quitting) {
+        close(fd);
+        return;
+    }
+    // A quitting connection only waits to drain, so it stops listening
+    // for input (a half-closed peer would keep EPOLLIN firing); one
+    // waiting for another shard reads nothing more until the reply is in.
+    const bool reading = !c.quitting && !c.eof && !c.waiting;
+    std::uint32_t want = (reading ? EPOLLIN | EPOLLRDHUP : 0) | (c.out.empty() ? 0 : EPOLLOUT);
+    if (want != c.events) {
+        epoll_event ev{};
+        ev.events = want;
+        ev.data.fd = fd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+        c.events = want;
+    }
+}
+
+void MatchServer::Shard::close(int fd) {
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+}
+
+//
+// Mail between shards: a command for a match owned by another shard goes
+// there, runs on that shard's thread and comes back as the reply.
+//
+void MatchServer::Shard::send(int shard, Mail* mail) {
+    Shard& to = *server._shards[static_cast<std::size_t>(shard)];
+    to.mailbox.push(mail);
+    std::uint64_t one = 1;
+    ssize_t w = ::write(to.wakeFd, &one, sizeof(one));
+    (void)w;
+}
+
+void MatchServer::Shard::onMail() {
+    std::uint64_t count;
+    ssize_t r = ::read(wakeFd, &count, sizeof(count));
+    (void)r;
+    for (Mail* m = mailbox.take(); m;) {
+        Mail* next = m->next;
+        if (!m->reply) {
+            std::string_view args[kMaxArgs];
+            int n = splitArgs(m->text, args);
+            std::string out;
+            execute(args, n, out);
+            m->text = std::move(out);
+            m->reply = true;
+            send(m->from, m);
+        } else {
+            auto it = connections.find(m->fd);
+            if (it != connections.end() && it->second.serial == m->serial) {
+                Connection& c = it->second;
+                c.out += m->text;
+                c.waiting = false;
+                serve(m->fd, c);
+                flush(m->fd, c);
+            }
+            delete m;
+        }
+        m = next;
+    }
+}
+
+//
+// Reaction windows
+//
+std::uint64_t MatchServer::Shard::tick() const {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+//
+// A window closed: resolve the match's pending actions and pass the turn.
+//
+void MatchServer::Shard::expire(std::uint64_t id) {
+    auto it = matches.find(id);
+    if (it == matches.end()) return;
+    it->second.window = TimerWheel::kNoTimer;
+    it->second.arena->game().nextTurn();
+}
+
+//
+// Give a declared action its window. A match has at most one open: nothing
+// else can be declared until it closes, so clients cannot keep it open.
+//
+void MatchServer::Shard::openWindow(std::string_view id, Match& match, std::string& out) {
+    std::uint64_t v = 0;
+    parseNumber(id, v);
+    match.window = windows.schedule(static_cast<std::uint64_t>(server.windowMs()), v);
+    openWindows.store(windows.size(), std::memory_order_relaxed);
+    out += "OK window=";
+    appendNumber(out, static_cast<std::uint64_t>(server.windowMs()));
+    out += '\n';
+}
+
+void MatchServer::Shard::closeWindow(Match& match) {
+    if (match.window == TimerWheel::kNoTimer) return;
+    windows.cancel(match.window);
+    match.window = TimerWheel::kNoTimer;
+    openWindows.store(windows.size(), std::memory_order_relaxed);
+}
+
+//
+// Commands
+//
+void MatchServer::Shard::handle(std::string_view line, int fd, Connection& c) {
+    std::string_view args[kMaxArgs];
+    int n = splitArgs(line, args);
+    if (n < 0) {
+        c.out += "ERR too many arguments\n";
+        return;
+    }
+    if (n == 0) return;
+    if (args[0] == "QUIT") {
+        c.quitting = true;
+        return;
+    }
+    const int owner = ownerOf(args, n);
+    if (owner != index) {
+        Mail* mail = new Mail;
+        mail->from = index;
+        mail->fd = fd;
+        mail->serial = c.serial;
+        mail->text.assign(line.data(), line.size());
+        c.waiting = true;
+        send(owner, mail);
+        return;
+    }
+    execute(args, n, c.out);
+}
+
+//
+// Shard that must run a command: the one in the match id for commands
+// on a match (id % shards), this one for the rest and for bad ids.
+//
+int MatchServer::Shard::ownerOf(const std::string_view* args, int n) const {
+    const std::string_view cmd = args[0];
+    std::uint64_t id = 0;
+    if (n < 2 || !(cmd == "ACT" || cmd == "BLOCK" || cmd == "STATE" || cmd == "END")
+        || !parseNumber(args[1], id)) {
+        return index;
+    }
+    return static_cast<int>(id % static_cast<std::uint64_t>(server.shards()));
+}
+
+void MatchServer::Shard::execute(const std::string_view* args, int n, std::string& out) {
+    const std::string_view cmd = args[0];
+    if (cmd == "ACT") {
+        auto start = std::chrono::steady_clock::now();
+        cmdAct(args, n, out);
+        latency.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    } else if (cmd == "BLOCK") {
+        cmdBlock(args, n, out);
+    } else if (cmd == "NEW") {
+        cmdNew(args, n, out);
+    } else if (cmd == "STATE") {
+        cmdState(args, n, out);
+    } else if (cmd == "END") {
+        if (n != 2) {
+            out += "ERR usage: END <match>\n";
+        } else if (Match* match = find(args[1], out)) {
+            std::uint64_t id = 0;
+            parseNumber(args[1], id);
+            closeWindow(*match);
+            matches.erase(id);
+            liveMatches.store(matches.size(), std::memory_order_relaxed);
+            out += "OK\n";
+        }
+    } else if (cmd == "STATS") {
+        out += "OK ";
+        out += server.statsLine();
+        out += '\n';
+    } else {
+        out += "ERR unknown command\n";
+    }
+}
+
+//
+// The match named by id, or nullptr with the error already in out.
+//
+MatchServer::Shard::Match* MatchServer::Shard::find(std::string_view id, std::string& out) {
+    std::uint64_t v = 0;
+    if (!parseNumber(id, v)) {
+        out += "ERR bad match id\n";
+        return nullptr;
+    }
+    auto it = matches.find(v);
+    if (it == matches.end()) {
+        out += "ERR no such match\n";
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void MatchServer::Shard::cmdNew(const std::string_view* args, int n, std::string& out) {
+    RoleId roles[kMaxTable];
+    if (n < 3 || n > kMaxTable + 1) {
+        out += "ERR usage: NEW <Role> <Role> [...] (2-6 roles)\n";
+        return;
+    }
+    for (int i = 1; i < n; ++i) {
+        if (!parseRole(args[i], roles[i - 1])) {
+            out += "ERR unknown role\n";
+            return;
+        }
+    }
+    auto arena = std::make_unique<MatchArena>(kMatchBytes);
+    for (int seat = 0; seat < n - 1; ++seat) {
+        visitRole(roles[seat], [&](const auto& role) {
+            using R = std::decay_t<decltype(role)>;
+            arena->addPlayer<R>(kSeatNames[seat]);
+        });
+    }
+    const std::uint64_t id = nextMatch++ * static_cast<std::uint64_t>(server.shards()) + index;
+    matches.emplace(id, Match{std::move(arena)});
+    liveMatches.store(matches.size(), std::memory_order_relaxed);
+    out += "OK ";
+    appendNumber(out, id);
+    out += '\n';
+}
+
+void MatchServer::Shard::cmdAct(const std::string_view* args, int n, std::string& out) {
+    if (n < 4 || n > 5) {
+        out += "ERR usage: ACT <match> <seat> <Action> [<target>]\n";
+        return;
+    }
+    Match* match = find(args[1], out);
+    if (!match) return;
+    Game& game = match->arena->game();
+    int seat = 0;
+    int target = GameState::kNoSeat;
+    ActionType type;
+    if (!parseMove(args, n, seat, type, target)) {
+        out += "ERR bad arguments\n";
+        return;
+    }
+    Player* player = game.playerAt(seat);
+    bool targeted = type == ActionType::Arrest || type == ActionType::Sanction || type == ActionType::Coup;
+    if (!player || (targeted && !game.playerAt(target))) {
+        out += "ERR InvalidPlayer\n";
+        return;
+    }
+    if (match->window != TimerWheel::kNoTimer) {
+        out += "ERR window open\n";
+        return;
+    }
+    ActionResult r = game.declare(seat, {type, targeted ? target : GameState::kNoSeat});
+    if (r != ActionResult::Ok) {
+        appendError(out, r);
+        return;
+    }
+    if (type != ActionType::Gather) {   // pending until its window closes
+        openWindow(args[1], *match, out);
+        return;
+    }
+    game.nextTurn();
+    out += "OK turn=";
+    appendSeat(out, game.state().currentSeat());
+    out += '\n';
+}
+
+//
+// BLOCK goes through the match's action inbox, which applies it with the
+// checks of GameState::block() and hands back the outcome.
+//
+void MatchServer::Shard::cmdBlock(const std::string_view* args, int n, std::string& out) {
+    if (n != 5) {
+        out += "ERR usage: BLOCK <match> <seat> <Action> <target>\n";
+        return;
+    }
+    Match* match = find(args[1], out);
+    if (!match) return;
+    int seat = 0;
+    int target = GameState::kNoSeat;
+    ActionType type;
+    if (!parseMove(args, n, seat, type, target)) {
+        out += "ERR bad arguments\n";
+        return;
+    }
+    Game& game = match->arena->game();
+    ActionResult r = ActionResult::InvalidPlayer;
+    game.post({InboxCommand::Block, type, static_cast<std::int8_t>(seat), static_cast<std::int8_t>(target), 0});
+    game.drainInbox([&](const InboxCommand&, ActionResult result) { r = result; });
+    if (r != ActionResult::Ok) {
+        appendError(out, r);
+        return;
+    }
+    out += "OK\n";
+}
+
+void MatchServer::Shard::cmdState(const std::string_view* args, int n, std::string& out) {
+    if (n != 2) {
+        out += "ERR usage: STATE <match>\n";
+        return;
+    }
+    Match* match = find(args[1], out);
+    if (!match) return;
+    const GameState& s = match->arena->game().state();
+    out += "OK turn=";
+    appendSeat(out, s.currentSeat());
+    out += " pool=";
+    appendNumber(out, static_cast<std::uint64_t>(s.pool));
+    out += " coins=";
+    for (int seat = 0; seat < s.seatCount; ++seat) {
+        if (seat > 0) out += ',';
+        appendNumber(out, static_cast<std::uint64_t>(s.coins[seat]));
+    }
+    out += " alive=";
+    appendNumber(out, s.alive);
+    out += '\n';
+}
+
+//
+// Server
+//
+MatchServer::MatchServer(const std::string& path, int shards, int windowMs)
+    : _path(path), _listenFd(-1), _windowMs(windowMs > 0 ? windowMs : 1) {
+    if (shards <= 0) shards = static_cast<int>(std::thread::hardware_concurrency());
+    if (shards <= 0) shards = 1;
+    for (int i = 0; i < shards; ++i) _shards.push_back(std::make_unique<Shard>(*this, i));
+}
+
+MatchServer::~MatchServer() {
+    stop();
+}
+
+void MatchServer::start() {
+    if (_listenFd >= 0) {
+        throw std::runtime_error("MatchServer already started");
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (_path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + _path);
+    }
+    std::memcpy(addr.sun_path, _path.c_str(), _path.size() + 1);
+    _listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (_listenFd < 0) fail("socket");
+    ::unlink(_path.c_str());
+    if (::bind(_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+        || ::listen(_listenFd, SOMAXCONN) != 0) {
+        int err = errno;
+        stop();
+        errno = err;
+        fail(("bind " + _path).c_str());
+    }
+
+    for (auto& shard : _shards) {
+        shard->epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        shard->wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event wake{};
+        wake.events = EPOLLIN;
+        wake.data.fd = shard->wakeFd;
+        epoll_event listen{};
+        listen.events = EPOLLIN | EPOLLEXCLUSIVE;
+        listen.data.fd = _listenFd;
+        if (shard->epollFd < 0 || shard->wakeFd < 0
+            || ::epoll_ctl(shard->epollFd, EPOLL_CTL_ADD, shard->wakeFd, &wake) != 0
+            || ::epoll_ctl(shard->epollFd, EPOLL_CTL_ADD, _listenFd, &listen) != 0) {
+            int err = errno;
+            stop();
+            errno = err;
+            fail("epoll");
+        }
+    }
+    for (auto& shard : _shards) {
+        shard->stopping.store(false, std::memory_order_relaxed);
+        shard->thread = std::thread(&Shard::run, shard.get(), _listenFd);
+    }
+}
+
+//
+// Shards send each other mail until they stop, so every one is told and
+// joined before any eventfd is closed.
+//
+void MatchServer::stop() {
+    for (auto& shard : _shards) {
+        if (shard->thread.joinable()) {
+            shard->stopping.store(true, std::memory_order_release);
+            std::uint64_t one = 1;
+            ssize_t w = ::write(shard->wakeFd, &one, sizeof(one));
+            (void)w;
+        }
+    }
+    for (auto& shard : _shards) {
+        if (shard->thread.joinable()) shard->thread.join();
+    }
+    for (auto& shard : _shards) {
+        if (shard->epollFd >= 0) ::close(shard->epollFd);
+        if (shard->wakeFd >= 0) ::close(shard->wakeFd);
+        shard->epollFd = -1;
+        shard->wakeFd = -1;
+    }
+    if (_listenFd >= 0) {
+        ::close(_listenFd);
+        ::unlink(_path.c_str());
+        _listenFd = -1;
+    }
+}
+
+std::vector<MatchServer::ShardStats> MatchServer::stats() const {
+    std::vector<ShardStats> out;
+    out.reserve(_shards.size());
+    for (const auto& shard : _shards) {
+        const LatencyHistogram& h = shard->latency;
+        out.push_back({shard->liveMatches.load(std::memory_order_relaxed),
+                       shard->openWindows.load(std::memory_order_relaxed), h.count(),
+                       h.percentile(0.50), h.percentile(0.90), h.percentile(0.99),
+                       h.percentile(0.999), h.max()});
+    }
+    return out;
+}
+
+std::string MatchServer::statsLine() const {
+    std::string line;
+    std::vector<ShardStats> all = stats();
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        const ShardStats& s = all[i];
+        if (i > 0) line += "; ";
+        line += "shard=" + std::to_string(i) + " matches=" + std::to_string(s.matches)
+              + " windows=" + std::to_string(s.windows) + " turns=" + std::to_string(s.turns) + " p50=" + std::to_string(s.p50)
+              + "ns p90=" + std::to_string(s.p90) + "ns p99=" + std::to_string(s.p99)
+              + "ns p999=" + std::to_string(s.p999) + "ns max=" + std::to_string(s.max) + "ns";
+    }
+    return line;
+}
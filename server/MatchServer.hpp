@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Hosts many matches in one process behind a Unix-domain socket.
+ *
+ * The server runs a fixed number of shards, each a thread with its own
+ * epoll loop. All shards wait on the one listening socket (EPOLLEXCLUSIVE),
+ * so the kernel hands every new connection to a single shard, which owns
+ * it from then on. A match lives on the shard whose connection created it
+ * (the shard is the match id modulo the shard count) and is only ever
+ * touched by that shard's thread, so Game itself stays single-threaded.
+ * A command for a match on another shard is mailed there: each shard has
+ * a lock-free mailbox and an eventfd, the owner runs the command and
+ * mails the reply back, and the connection answers nothing else in the
+ * meantime, so replies stay in command order. Apart from the mailboxes,
+ * shards share only relaxed counters; there are no locks.
+ *
+ * The protocol is line-based text, one reply line per command, so it can
+ * be scripted with socat or nc -U:
+ *
+ *   NEW <Role> <Role> [...]                  OK <match>      (2-6 built-in roles; seats 0..n-1)
+ *   ACT <match> <seat> <Action> [<target>]   OK turn=<seat> | OK window=<ms> | ERR window open | ERR <ActionResult>
+ *   BLOCK <match> <seat> <Action> <target>   OK | ERR <ActionResult>
+ *   STATE <match>                            OK turn=<seat> pool=<n> coins=<c0>,<c1>,... alive=<mask>
+ *   END <match>                              OK
+ *   STATS                                    OK shard=0 matches=.. windows=.. turns=.. p50=..ns p90=..ns p99=..ns
+ *                                               p999=..ns max=..ns; shard=1 ...
+ *   QUIT                                     (closes the connection)
+ *
+ * Actions are Gather, Tax, Bribe, Arrest, Sanction and Coup, declared for
+ * the given seat with the turn, role and cost checks of Game::declare().
+ * A Gather cannot be blocked, so ACT passes the turn at once; any other
+ * action is left pending and ACT opens the match's reaction window. When
+ * it closes, the shard calls Game::nextTurn(), which resolves the pending
+ * action and passes the turn. Turn latency is the time the owning shard
+ * takes to run an ACT, recorded per shard.
+ *
+ * BLOCK goes through the match's action inbox: it blocks a pending action,
+ * its target being the actor of a Tax or Bribe or the target of the
+ * others, if the seat's role can (GameState::block()). A match has one
+ * window at a time: ACT is refused while it is open, so no client can
+ * hold it open by declaring again. Windows live in one TimerWheel per
+ * shard, ticking in milliseconds, so opening and closing one is O(1)
+ * however many are open. An ACT or BLOCK sent from another shard's connection is mailed like
+ * any match command, so the window is always on the match's own shard.
+ */
+class MatchServer {
+public:
+    /// Most players in a hosted match.
+    static constexpr int kMaxTable = 6;
+
+    /**
+     * @brief Turn latency and load of one shard (latencies in ns).
+     */
+    struct ShardStats {
+        std::uint64_t matches;  ///< Live matches.
+        std::uint64_t windows;  ///< Open reaction windows.
+        std::uint64_t turns;    ///< ACT commands handled.
+        std::uint64_t p50;
+        std::uint64_t p90;
+        std::uint64_t p99;
+        std::uint64_t p999;
+        std::uint64_t max;
+    };
+
+    /**
+     * @brief Configure a server; nothing is opened until start().
+     * @param path   Socket path (replaced if it exists).
+     * @param shards Worker shards (0 → hardware concurrency).
+     * @param windowMs Reaction window of a declared action, in milliseconds.
+     */
+    explicit MatchServer(const std::string& path, int shards = 0, int windowMs = 2000);
+
+    /// stop(), then release everything.
+    ~MatchServer();
+
+    MatchServer(const MatchServer&) = delete;
+    MatchServer& operator=(const MatchServer&) = delete;
+
+    /**
+     * @brief Bind the socket and start the shard threads.
+     * Throws std::runtime_error if the socket cannot be set up.
+     */
+    void start();
+
+    /**
+     * @brief Stop the shards, close every connection, drop every match and
+     * remove the socket. Safe to call more than once.
+     */
+    void stop();
+
+    /// Number of shards.
+    int shards() const { return static_cast<int>(_shards.size()); }
+
+    /// Reaction window length in milliseconds.
+    int windowMs() const { return _windowMs; }
+
+    /// Current turn latency percentiles and load of every shard.
+    std::vector<ShardStats> stats() const;
+
+    /// One line describing stats(), as STATS replies it (without "OK ").
+    std::string statsLine() const;
+
+private:
+    struct Shard;
+
+    std::string                         _path;
+    int                                 _listenFd;
+    int                                 _windowMs;
+    std::vector<std::unique_ptr<Shard>> _shards;
+};
@@ -0,0 +1,117 @@
+#include "TimerWheel.hpp"
+
+TimerWheel::TimerWheel(std::uint64_t now, std::size_t reserve)
+    : _now(now), _size(0), _free(kNil) {
+    _nodes.reserve(reserve);
+    for (auto& level : _heads) {
+        for (std::uint32_t& head : level) head = kNil;
+    }
+    for (std::uint64_t& bits : _occupied) bits = 0;
+}
+
+TimerWheel::Handle TimerWheel::schedule(std::uint64_t delay, std::uint64_t cookie) {
+    if (delay < 1) delay = 1;
+    if (delay > kMaxDelay) delay = kMaxDelay;
+    std::uint32_t i = _free;
+    if (i != kNil) {
+        _free = _nodes[i].next;
+    } else {
+        i = static_cast<std::uint32_t>(_nodes.size());
+        _nodes.push_back(Node{0, 0, kNil, kNil, 0, -1});
+    }
+    Node& n = _nodes[i];
+    n.expires = _now + delay;
+    n.cookie = cookie;
+    link(i);
+    ++_size;
+    return static_cast<Handle>(n.generation) << 32 | i;
+}
+
+bool TimerWheel::cancel(Handle handle) {
+    const std::uint32_t i = static_cast<std::uint32_t>(handle);
+    if (handle == kNoTimer || i >= _nodes.size()) return false;
+    const Node& n = _nodes[i];
+    if (n.slot < 0 || n.generation != static_cast<std::uint32_t>(handle >> 32)) return false;
+    release(i);
+    return true;
+}
+
+std::uint64_t TimerWheel::nextDeadline() const {
+    // Level 0 holds exactly the timers due in (now, now + 63]: rotate its
+    // bits so that tick now + 1 is bit 0 and take the lowest. Timers higher
+    // up need the next boundary's cascade first.
+    std::uint64_t next = ~std::uint64_t(0);
+    const unsigned shift = static_cast<unsigned>((_now + 1) & (kSlots - 1));
+    const std::uint64_t bits = _occupied[0];
+    const std::uint64_t rotated = shift ? (bits >> shift | bits << (kSlots - shift)) : bits;
+    if (rotated) next = _now + 1 + static_cast<std::uint64_t>(__builtin_ctzll(rotated));
+    for (int level = 1; level < kLevels; ++level) {
+        if (_occupied[level]) {
+            const std::uint64_t boundary = (_now | (kSlots - 1)) + 1;
+            return boundary < next ? boundary : next;
+        }
+    }
+    return next;
+}
+
+//
+// Put node i into the slot of the lowest level that spans its delay.
+//
+void TimerWheel::link(std::uint32_t i) {
+    Node& n = _nodes[i];
+    const std::uint64_t delta = n.expires - _now;
+    int level = 0;
+    while (level < kLevels - 1 && delta >> ((level + 1) * kSlotBits)) ++level;
+    const int slot = static_cast<int>((n.expires >> (level * kSlotBits)) & (kSlots - 1));
+    std::uint32_t& head = _heads[level][slot];
+    n.slot = static_cast<std::int16_t>(level * kSlots + slot);
+    n.prev = kNil;
+    n.next = head;
+    if (head != kNil) _nodes[head].prev = i;
+    head = i;
+    _occupied[level] |= std::uint64_t(1) << slot;
+}
+
+void TimerWheel::unlink(std::uint32_t i) {
+    Node& n = _nodes[i];
+    const int level = n.slot / kSlots;
+    const int slot = n.slot % kSlots;
+    if (n.prev != kNil) _nodes[n.prev].next = n.next;
+    else _heads[level][slot] = n.next;
+    if (n.next != kNil) _nodes[n.next].prev = n.prev;
+    if (_heads[level][slot] == kNil) _occupied[level] &= ~(std::uint64_t(1) << slot);
+    n.slot = -1;
+}
+
+//
+// Unlink node i and return it to the free list; bumping the generation
+// turns every handle to it stale.
+//
+void TimerWheel::release(std::uint32_t i) {
+    unlink(i);
+    Node& n = _nodes[i];
+    ++n.generation;
+    n.next = _free;
+    _free = i;
+    --_size;
+}
+
+//
+// At a 64-tick boundary, empty the current slot of every level whose own
+// boundary this is (highest first) into the levels below.
+//
+void TimerWheel::cascade() {
+    int top = 1;
+    while (top < kLevels - 1 && (_now & ((std::uint64_t(1) << ((top + 1) * kSlotBits)) - 1)) == 0) ++top;
+    for (int level = top; level >= 1; --level) {
+        const int slot = static_cast<int>((_now >> (level * kSlotBits)) & (kSlots - 1));
+        std::uint32_t i = _heads[level][slot];
+        _heads[level][slot] = kNil;
+        _occupied[level] &= ~(std::uint64_t(1) << slot);
+        while (i != kNil) {
+            const std::uint32_t next = _nodes[i].next;
+            link(i);
+            i = next;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Hierarchical timing wheel: O(1) schedule and cancel for many
+ * timers on one thread.
+ *
+ * Time is counted in ticks (the caller picks the unit; MatchServer uses
+ * milliseconds). Four levels of 64 slots cover delays up to 64^4 - 1
+ * ticks; longer delays are clamped. A timer sits in the lowest level whose
+ * span covers its delay, in the slot of its expiry tick. Every 64 ticks
+ * the next slot of the level above is emptied into the one below, so a
+ * timer is moved at most three times before it fires. Each slot is an
+ * intrusive list of nodes kept in one vector, and each level keeps a bit
+ * per non-empty slot, so finding the next deadline is a few bit scans.
+ *
+ * Handles carry a generation, so cancelling a timer that already fired
+ * (or was cancelled) is a harmless no-op. Not thread-safe.
+ */
+class TimerWheel {
+public:
+    using Handle = std::uint64_t;
+
+    static constexpr Handle        kNoTimer = ~Handle(0);
+    static constexpr int           kLevels = 4;
+    static constexpr int           kSlotBits = 6;
+    static constexpr int           kSlots = 1 << kSlotBits;
+    static constexpr std::uint64_t kMaxDelay = (std::uint64_t(1) << (kLevels * kSlotBits)) - 1;
+
+    /**
+     * @brief An empty wheel whose clock reads now.
+     * @param reserve Timers to make room for up front.
+     */
+    explicit TimerWheel(std::uint64_t now = 0, std::size_t reserve = 0);
+
+    /// The wheel's clock: the last tick passed to advance().
+    std::uint64_t now() const { return _now; }
+
+    /// Timers waiting to fire.
+    std::size_t size() const { return _size; }
+
+    /**
+     * @brief Fire cookie after delay ticks (at least 1, at most kMaxDelay).
+     * @return A handle for cancel().
+     */
+    Handle schedule(std::uint64_t delay, std::uint64_t cookie);
+
+    /**
+     * @brief Drop a waiting timer.
+     * @return False if it already fired or was cancelled.
+     */
+    bool cancel(Handle handle);
+
+    /**
+     * @brief The earliest tick at which advance() may have something to do,
+     * or UINT64_MAX if no timer is waiting: the next level-0 deadline, or
+     * the next 64-tick boundary if that comes first and a cascade is due.
+     */
+    std::uint64_t nextDeadline() const;
+
+    /**
+     * @brief Move the clock to now, firing every timer due by then in
+     * expiry order as onExpire(cookie). The callback may schedule and
+     * cancel timers.
+     * @return Number of timers fired.
+     */
+    template <typename F>
+    std::size_t advance(std::uint64_t now, F&& onExpire) {
+        std::size_t fired = 0;
+        while (_now < now) {
+            std::uint64_t next = nextDeadline();
+            _now = next < now ? next : now;
+            if ((_now & (kSlots - 1)) == 0) cascade();
+            const int slot = static_cast<int>(_now & (kSlots - 1));
+            for (std::uint32_t i; (i = _heads[0][slot]) != kNil;) {
+                const std::uint64_t cookie = _nodes[i].cookie;
+                release(i);
+                onExpire(cookie);
+                ++fired;
+            }
+        }
+        return fired;
+    }
+
+private:
+    static constexpr std::uint32_t kNil = ~std::uint32_t(0);
+
+    struct Node {
+        std::uint64_t expires;
+        std::uint64_t cookie;
+        std::uint32_t prev;
+        std::uint32_t next;        ///< Also links the free list.
+        std::uint32_t generation;
+        std::int16_t  slot;        ///< level * kSlots + slot, or -1 when free.
+    };
+
+    std::uint64_t      _now;
+    std::size_t        _size;
+    std::vector<Node>  _nodes;
+    std::uint32_t      _free;                      ///< Head of the free node list.
+    std::uint32_t      _heads[kLevels][kSlots];
+    std::uint64_t      _occupied[kLevels];         ///< Bit s set if slot s has timers.
+
+    void link(std::uint32_t i);
+    void unlink(std::uint32_t i);
+    void release(std::uint32_t i);
+    void cascade();
+};
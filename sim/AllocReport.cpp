@@ -0,0 +1,114 @@
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "../include/AllocProfile.hpp"
+#include "../include/Exceptions.hpp"
+#include "../include/Game.hpp"
+#include "../include/Player.hpp"
+
+/**
+ * @brief Driver for the allocation profiler.
+ *
+ * Plays random six-role matches through the Game/Player facade, the way a
+ * GUI or server does: Player actions, blocks by the role that can block,
+ * turn() and players() every turn, and one out-of-turn attempt per turn so
+ * the exception path is counted too. Built with COUP_ALLOC_PROFILE
+ * (`make profile`), the per-site table is printed at exit.
+ *
+ * Usage:
+ *   alloc_profile [-n matches] [-s seed] [-m maxTurns]
+ */
+
+namespace {
+
+// Play one of p's legal moves through the throwing Player methods.
+void play(Game& game, Player& p, const Action& a) {
+    Player* target = game.playerAt(a.target);
+    switch (a.type) {
+        case ActionType::Gather:   p.gather(); break;
+        case ActionType::Tax:      p.tax(); break;
+        case ActionType::Bribe:    p.bribe(); break;
+        case ActionType::Arrest:   p.arrest(*target); break;
+        case ActionType::Sanction: p.sanction(*target); break;
+        case ActionType::Coup:     p.coup(*target); break;
+    }
+}
+
+// Let the role that can block a's type block it, if it is still in play.
+void maybeBlock(Game& game, Player* actor, const Action& a, Player* const* table) {
+    Player* target = a.target == GameState::kNoSeat ? actor : game.playerAt(a.target);
+    try {
+        switch (a.type) {
+            case ActionType::Tax:      game.blockTax(table[0], actor); break;
+            case ActionType::Arrest:   game.blockArrest(table[1], actor); break;
+            case ActionType::Sanction: game.blockSanction(table[4], target); break;
+            case ActionType::Bribe:    game.blockBribe(table[4], actor); break;
+            case ActionType::Coup:     game.blockCoup(table[3], target); break;
+            default: break;
+        }
+    } catch (const std::exception&) {
+        // Blocker out of coins, or the action already resolved
+    }
+}
+
+void playMatch(std::mt19937_64& rng, int maxTurns) {
+    Game game;
+    Player gov("Governor", RoleId::Governor, &game);
+    Player spy("Spy", RoleId::Spy, &game);
+    Player baron("Baron", RoleId::Baron, &game);
+    Player general("General", RoleId::General, &game);
+    Player judge("Judge", RoleId::Judge, &game);
+    Player merchant("Merchant", RoleId::Merchant, &game);
+    Player* const table[] = {&gov, &spy, &baron, &general, &judge, &merchant};
+    for (Player* p : table) game.addPlayer(p);
+
+    ActionBuffer legal;
+    for (int turn = 0; turn < maxTurns && game.players().size() > 1; ++turn) {
+        std::string name = game.turn();
+        Player* p = game.playerAt(game.state().currentSeat());
+
+        // Someone else tries to act out of turn
+        Player* other = table[std::uniform_int_distribution<int>(0, 5)(rng)];
+        if (other != p && game.state().isAlive(other->id())) {
+            try {
+                other->gather();
+            } catch (const std::exception&) {
+            }
+        }
+
+        game.legalActions(*p, legal);
+        if (legal.empty()) break;
+        const Action a = legal[std::uniform_int_distribution<int>(0, legal.size() - 1)(rng)];
+        play(game, *p, a);
+        if (std::uniform_int_distribution<int>(0, 3)(rng) == 0) maybeBlock(game, p, a, table);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long matches = 10000;
+    unsigned long long seed = 1;
+    int maxTurns = 1000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "-n" && hasValue)      matches  = std::atol(argv[++i]);
+        else if (arg == "-s" && hasValue) seed     = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "-m" && hasValue) maxTurns = std::atoi(argv[++i]);
+        else {
+            std::fprintf(stderr, "usage: alloc_profile [-n matches] [-s seed] [-m maxTurns]\n");
+            return 1;
+        }
+    }
+    if (!AllocProfile::enabled()) {
+        std::fprintf(stderr, "alloc_profile: built without COUP_ALLOC_PROFILE, nothing is counted\n");
+    }
+
+    std::mt19937_64 rng(seed);
+    for (long m = 0; m < matches; ++m) playMatch(rng, maxTurns);
+    std::printf("%ld matches played\n", matches);
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "../ai/ParallelMcts.hpp"
+#include "../include/GameState.hpp"
+
+/**
+ * @brief Scaling benchmark for ParallelMcts.
+ *
+ * Searches the opening position of a six-role match for a fixed wall-clock
+ * time at 1, 2, 4, 8, 16 and 32 threads, in Tree and Root mode, and reports
+ * playouts per second and the speedup over one thread.
+ *
+ * Usage:
+ *   mcts_scaling [-t millisPerRun] [-s seed]
+ */
+int main(int argc, char** argv) {
+    double millis = 1000;
+    unsigned long long seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "-t" && hasValue)      millis = std::atof(argv[++i]);
+        else if (arg == "-s" && hasValue) seed   = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::fprintf(stderr, "usage: mcts_scaling [-t millisPerRun] [-s seed]\n");
+            return 1;
+        }
+    }
+
+    GameState initial;
+    for (int r = 0; r < static_cast<int>(RoleId::Custom); ++r) {
+        RoleId role = static_cast<RoleId>(r);
+        initial.addSeat(role, GameState::abilitiesOf(role), 0);
+    }
+    const SearchState root(initial);
+
+    MctsConfig config;
+    config.iterations = 0;
+    config.timeLimitMs = millis;
+    config.seed = seed;
+
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    const ParallelMcts::Mode modes[] = {ParallelMcts::Mode::Tree, ParallelMcts::Mode::Root};
+
+    std::printf("%-6s %8s %14s %9s\n", "mode", "threads", "playouts/sec", "speedup");
+    for (ParallelMcts::Mode mode : modes) {
+        double base = 0;
+        for (int threads : threadCounts) {
+            ParallelMcts::Options options;
+            options.threads = threads;
+            options.mode = mode;
+            ParallelMcts search(config, options);
+            search.search(root);
+            double rate = search.playouts() / (millis / 1000.0);
+            if (threads == 1) base = rate;
+            std::printf("%-6s %8d %14.0f %8.2fx\n",
+                        mode == ParallelMcts::Mode::Tree ? "tree" : "root",
+                        threads, rate, base > 0 ? rate / base : 0.0);
+        }
+    }
+    return 0;
+}
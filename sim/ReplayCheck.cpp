@@ -0,0 +1,138 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/Agent.hpp"
+#include "../include/Baron.hpp"
+#include "../include/General.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Judge.hpp"
+#include "../include/MatchArena.hpp"
+#include "../include/Merchant.hpp"
+#include "../include/ReplayLog.hpp"
+#include "../include/ReplayReader.hpp"
+#include "../include/Spy.hpp"
+
+/**
+ * @brief Re-simulates replay files against the current rules.
+ *
+ * Every match of every file is replayed into a fresh Game (see Resimulator)
+ * and its final coins, pool and winner are checked against the recorded
+ * result. Each mismatch is printed with the first event that diverged,
+ * followed by a summary with the replay rate. The exit status is 1 if any
+ * match diverged.
+ *
+ * Usage:
+ *   replay_check [-q] file...
+ *   replay_check -r matches [-s seed] [-m maxTurns] file
+ *
+ * -q prints the summary only. -r appends that many random six-player
+ * self-play matches (Game::apply, one of each role) to file, for building a
+ * test corpus.
+ */
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr,
+        "usage: replay_check [-q] file...\n"
+        "       replay_check -r matches [-s seed] [-m maxTurns] file\n");
+}
+
+int record(const char* path, long matches, unsigned long long seed, int maxTurns) {
+    ReplayWriter writer(path);
+    MatchArena arena;
+    RandomAgent agent;
+    std::mt19937_64 rng(seed);
+    for (long m = 0; m < matches; ++m) {
+        Game& game = arena.game();
+        writer.beginMatch(static_cast<std::uint64_t>(m));
+        game.setReplayWriter(&writer);
+        arena.addPlayer<Governor>("Governor");
+        arena.addPlayer<Spy>("Spy");
+        arena.addPlayer<Baron>("Baron");
+        arena.addPlayer<General>("General");
+        arena.addPlayer<Judge>("Judge");
+        arena.addPlayer<Merchant>("Merchant");
+        for (int t = 0; t < maxTurns && game.state().activeCount > 1; ++t) {
+            int seat = game.state().currentSeat();
+            if (game.apply(agent.choose(game.state(), seat, rng)) != ActionResult::Ok) {
+                game.apply({ActionType::Gather, GameState::kNoSeat});
+            }
+        }
+        game.setReplayWriter(nullptr);
+        writer.endMatch(game.state());
+        arena.reset();
+    }
+    writer.flush();
+    std::printf("%s: %ld matches, %llu bytes\n", path, matches,
+                static_cast<unsigned long long>(writer.bytesWritten()));
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool quiet = false;
+    long recordMatches = 0;
+    unsigned long long seed = 1;
+    int maxTurns = 1000;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-q")                  quiet = true;
+        else if (arg == "-r" && hasValue) recordMatches = std::atol(argv[++i]);
+        else if (arg == "-s" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "-m" && hasValue) maxTurns = std::atoi(argv[++i]);
+        else if (arg[0] != '-')           files.push_back(argv[i]);
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (files.empty() || (recordMatches > 0 && files.size() != 1)) {
+        usage();
+        return 1;
+    }
+
+    try {
+        if (recordMatches > 0) {
+            return record(files[0], recordMatches, seed, maxTurns);
+        }
+
+        long matches = 0;
+        long failed = 0;
+        std::uint64_t events = 0;
+        Resimulator sim;
+        Replay::Verdict verdict;
+        auto start = std::chrono::steady_clock::now();
+        for (const char* path : files) {
+            ReplayReader reader(path);
+            while (sim.run(reader, verdict)) {
+                ++matches;
+                events += verdict.events;
+                if (!verdict.ok) {
+                    ++failed;
+                    if (!quiet) {
+                        std::printf("%s: match %llu: %s\n", path,
+                                    static_cast<unsigned long long>(verdict.match),
+                                    verdict.reason.c_str());
+                    }
+                }
+            }
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%ld matches, %ld diverged, %llu events in %.3f s (%.1f M events/s)\n",
+                    matches, failed, static_cast<unsigned long long>(events), secs,
+                    secs > 0 ? events / secs / 1e6 : 0.0);
+        return failed > 0 ? 1 : 0;
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "replay_check: %s\n", ex.what());
+        return 2;
+    }
+}
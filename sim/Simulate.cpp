@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/Agent.hpp"
+#include "../include/GameState.hpp"
+#include "../ai/Mcts.hpp"
+
+/**
+ * @brief Headless self-play simulator.
+ *
+ * Runs N full matches of a role lineup on the flat GameState engine, spread
+ * over a pool of worker threads, and reports throughput, match length and
+ * win rates per role.
+ *
+ * Usage:
+ *   simulate [-n matches] [-j threads] [-s seed] [-m maxTurns]
+ *            [-a agent[,agent...]] [Role ...]
+ *
+ * Roles are Governor, Spy, Baron, General, Judge, Merchant (default: all six).
+ * Agents are "random", "heuristic" or "mcts" and are assigned to seats round-robin.
+ */
+
+namespace {
+
+constexpr int kRoleCount = static_cast<int>(RoleId::Custom);
+
+struct Options {
+    long        matches  = 100000;
+    int         threads  = 0;        // 0 → hardware concurrency
+    unsigned long long seed = 1;
+    int         maxTurns = 1000;
+    std::vector<std::string> agents{"heuristic"};
+    std::vector<RoleId>      lineup;
+};
+
+/// Per-thread tallies, merged at the end.
+struct Tally {
+    long matches = 0;
+    long turns   = 0;
+    long draws   = 0;
+    long wins[GameState::kMaxPlayers] = {};
+};
+
+/// splitmix64: decorrelates per-match seeds so results do not depend on threading.
+unsigned long long mix(unsigned long long x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+bool parseRole(const char* s, RoleId& out) {
+    for (int i = 0; i < kRoleCount; ++i) {
+        if (std::strcmp(s, roleIdName(static_cast<RoleId>(i))) == 0) {
+            out = static_cast<RoleId>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> splitCommas(const std::string& s) {
+    std::vector<std::string> out;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t end = s.find(',', start);
+        if (end == std::string::npos) end = s.size();
+        out.push_back(s.substr(start, end - start));
+        start = end + 1;
+    }
+    return out;
+}
+
+void usage() {
+    std::fprintf(stderr,
+        "usage: simulate [-n matches] [-j threads] [-s seed] [-m maxTurns]\n"
+        "                [-a agent[,agent...]] [Role ...]\n");
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "-n" && hasValue)      opt.matches  = std::atol(argv[++i]);
+        else if (arg == "-j" && hasValue) opt.threads  = std::atoi(argv[++i]);
+        else if (arg == "-s" && hasValue) opt.seed     = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "-m" && hasValue) opt.maxTurns = std::atoi(argv[++i]);
+        else if (arg == "-a" && hasValue) opt.agents   = splitCommas(argv[++i]);
+        else {
+            RoleId r;
+            if (!parseRole(argv[i], r)) {
+                std::fprintf(stderr, "unknown role or option: %s\n", argv[i]);
+                return false;
+            }
+            opt.lineup.push_back(r);
+        }
+    }
+    if (opt.lineup.empty()) {
+        for (int i = 0; i < kRoleCount; ++i) opt.lineup.push_back(static_cast<RoleId>(i));
+    }
+    if (opt.lineup.size() < 2 || opt.lineup.size() > static_cast<size_t>(GameState::kMaxPlayers)) {
+        std::fprintf(stderr, "lineup must have 2..%d roles\n", GameState::kMaxPlayers);
+        return false;
+    }
+    if (opt.matches <= 0 || opt.maxTurns <= 0) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage();
+        return 1;
+    }
+
+    // Agents are stateless, so one instance per seat is shared by all threads.
+    std::vector<std::unique_ptr<Agent>> owned;
+    std::vector<const Agent*> seatAgents;
+    for (size_t s = 0; s < opt.lineup.size(); ++s) {
+        const std::string& name = opt.agents[s % opt.agents.size()];
+        std::unique_ptr<Agent> a = makeAgent(name);
+        if (!a && name == "mcts") {
+            MctsConfig config;
+            config.iterations = 200;
+            a = std::make_unique<MctsAgent>(config);
+        }
+        if (!a) {
+            std::fprintf(stderr, "unknown agent: %s\n", name.c_str());
+            return 1;
+        }
+        seatAgents.push_back(a.get());
+        owned.push_back(std::move(a));
+    }
+
+    // Template state: every match starts from a memcpy of this.
+    GameState initial;
+    for (RoleId r : opt.lineup) {
+        initial.addSeat(r, GameState::abilitiesOf(r), 0);
+    }
+
+    int threads = opt.threads > 0 ? opt.threads
+                                  : static_cast<int>(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+
+    constexpr long kChunk = 256;
+    std::atomic<long> next{0};
+    std::vector<Tally> tallies(threads);
+
+    auto worker = [&](int t) {
+        Tally& tally = tallies[t];
+        std::mt19937_64 rng;
+        for (;;) {
+            long begin = next.fetch_add(kChunk, std::memory_order_relaxed);
+            if (begin >= opt.matches) break;
+            long end = std::min(begin + kChunk, opt.matches);
+            for (long m = begin; m < end; ++m) {
+                rng.seed(mix(opt.seed + static_cast<unsigned long long>(m)));
+                GameState state = initial;
+                PlayoutResult r = playOut(state, seatAgents.data(), rng, opt.maxTurns);
+                ++tally.matches;
+                tally.turns += r.turns;
+                if (r.winner == GameState::kNoSeat) ++tally.draws;
+                else ++tally.wins[r.winner];
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+    for (auto& th : pool) th.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Tally total;
+    for (const Tally& t : tallies) {
+        total.matches += t.matches;
+        total.turns   += t.turns;
+        total.draws   += t.draws;
+        for (int s = 0; s < GameState::kMaxPlayers; ++s) total.wins[s] += t.wins[s];
+    }
+
+    long roleWins[kRoleCount] = {};
+    int  roleSeats[kRoleCount] = {};
+    for (size_t s = 0; s < opt.lineup.size(); ++s) {
+        int r = static_cast<int>(opt.lineup[s]);
+        roleWins[r] += total.wins[s];
+        ++roleSeats[r];
+    }
+
+    std::printf("matches:      %ld\n", total.matches);
+    std::printf("threads:      %d\n", threads);
+    std::printf("elapsed:      %.3f s\n", secs);
+    std::printf("matches/sec:  %.0f\n", secs > 0 ? total.matches / secs : 0.0);
+    std::printf("avg turns:    %.2f\n", static_cast<double>(total.turns) / total.matches);
+    std::printf("draws:        %ld (turn limit %d)\n", total.draws, opt.maxTurns);
+    std::printf("win rate by role:\n");
+    for (int r = 0; r < kRoleCount; ++r) {
+        if (roleSeats[r] == 0) continue;
+        std::printf("  %-9s %6.2f%%  (%d seat%s)\n", roleIdName(static_cast<RoleId>(r)),
+                    100.0 * roleWins[r] / total.matches, roleSeats[r],
+                    roleSeats[r] == 1 ? "" : "s");
+    }
+    return 0;
+}
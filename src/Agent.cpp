@@ -0,0 +1,78 @@
+#include "../include/Agent.hpp"
+#include "../include/ActionBuffer.hpp"
+
+namespace {
+
+//
+// Living opponent with the most coins, ties broken uniformly at random.
+//
+int richestOpponent(const GameState& s, int self, std::mt19937_64& rng) {
+    int best = GameState::kNoSeat;
+    int ties = 0;
+    for (int i = 0; i < s.activeCount; ++i) {
+        int seat = s.order[i];
+        if (seat == self) continue;
+        if (best == GameState::kNoSeat || s.coins[seat] > s.coins[best]) {
+            best = seat;
+            ties = 1;
+        } else if (s.coins[seat] == s.coins[best]
+                   && std::uniform_int_distribution<int>(0, ties++)(rng) == 0) {
+            best = seat;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+//
+// RandomAgent: uniform over the legal moves.
+//
+Action RandomAgent::choose(const GameState& s, int seat, std::mt19937_64& rng) const {
+    ActionBuffer moves;
+    s.legalActions(seat, moves);
+    if (moves.empty()) return {ActionType::Gather, GameState::kNoSeat};
+    return moves[std::uniform_int_distribution<int>(0, moves.size() - 1)(rng)];
+}
+
+//
+// HeuristicAgent: coup when affordable, then the best income action.
+//
+Action HeuristicAgent::choose(const GameState& s, int seat, std::mt19937_64& rng) const {
+    int richest = richestOpponent(s, seat, rng);
+    if (s.coins[seat] >= 7 && richest != GameState::kNoSeat) {
+        return {ActionType::Coup, richest};
+    }
+    if (s.can(seat, GameState::CanTax)) {
+        return {ActionType::Tax, GameState::kNoSeat};
+    }
+    if (s.can(seat, GameState::CanArrest) && richest != GameState::kNoSeat
+        && s.coins[richest] > 0) {
+        return {ActionType::Arrest, richest};
+    }
+    return {ActionType::Gather, GameState::kNoSeat};
+}
+
+std::unique_ptr<Agent> makeAgent(const std::string& name) {
+    if (name == "random")    return std::make_unique<RandomAgent>();
+    if (name == "heuristic") return std::make_unique<HeuristicAgent>();
+    return nullptr;
+}
+
+//
+// Self-play loop: the current seat's agent moves until one seat is left
+// or maxTurns actions have been taken.
+//
+PlayoutResult playOut(GameState& state, const Agent* const* agents,
+                      std::mt19937_64& rng, int maxTurns) {
+    int turns = 0;
+    while (state.winner() == GameState::kNoSeat && state.activeCount > 0 && turns < maxTurns) {
+        int seat = state.currentSeat();
+        Action a = agents[seat]->choose(state, seat, rng);
+        if (state.apply(seat, a) != ActionResult::Ok) {
+            state.gather(seat);
+        }
+        ++turns;
+    }
+    return {state.winner(), turns};
+}
@@ -0,0 +1,155 @@
+#include "../include/AllocProfile.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace {
+
+//
+// Site table. Slot 0 collects allocations made outside every scope. All
+// counters are relaxed atomics so simulator threads can share the table;
+// only registration takes the lock, once per site.
+//
+struct Site {
+    const char*                name;
+    std::atomic<std::uint64_t> calls;
+    std::atomic<std::uint64_t> allocs;
+    std::atomic<std::uint64_t> bytes;
+};
+
+Site             gSites[AllocProfile::kMaxSites] = {{"(unattributed)", {0}, {0}, {0}}};
+std::atomic<int> gSiteCount{1};
+std::mutex       gRegisterLock;
+
+thread_local int tCurrent = 0;
+
+int find(const char* name, int count) {
+    for (int i = 0; i < count; ++i) {
+        if (gSites[i].name == name || std::strcmp(gSites[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+} // namespace
+
+namespace AllocProfile {
+
+bool enabled() {
+#ifdef COUP_ALLOC_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+int registerSite(const char* name) {
+    std::lock_guard<std::mutex> lock(gRegisterLock);
+    int count = gSiteCount.load(std::memory_order_relaxed);
+    int id = find(name, count);
+    if (id >= 0) return id;
+    if (count == kMaxSites) return 0;
+    gSites[count].name = name;
+    gSiteCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+void noteAllocation(std::size_t bytes) {
+    Site& s = gSites[tCurrent];
+    s.allocs.fetch_add(1, std::memory_order_relaxed);
+    s.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+SiteStats stats(const char* site) {
+    int id = find(site, gSiteCount.load(std::memory_order_acquire));
+    if (id < 0) return {site, 0, 0, 0};
+    const Site& s = gSites[id];
+    return {s.name, s.calls.load(std::memory_order_relaxed),
+            s.allocs.load(std::memory_order_relaxed), s.bytes.load(std::memory_order_relaxed)};
+}
+
+int snapshot(SiteStats* out) {
+    int count = gSiteCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        out[i] = stats(gSites[i].name);
+    }
+    return count;
+}
+
+void reset() {
+    int count = gSiteCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        gSites[i].calls.store(0, std::memory_order_relaxed);
+        gSites[i].allocs.store(0, std::memory_order_relaxed);
+        gSites[i].bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+void report(std::FILE* out) {
+    SiteStats all[kMaxSites];
+    int count = snapshot(all);
+    std::fprintf(out, "%-28s %12s %12s %14s %11s %11s\n",
+                 "site", "calls", "allocs", "bytes", "allocs/call", "bytes/call");
+    for (int i = 0; i < count; ++i) {
+        const SiteStats& s = all[i];
+        if (s.allocs == 0) continue;
+        double calls = s.calls ? static_cast<double>(s.calls) : 1.0;
+        std::fprintf(out, "%-28s %12llu %12llu %14llu %11.2f %11.1f\n", s.site,
+                     static_cast<unsigned long long>(s.calls),
+                     static_cast<unsigned long long>(s.allocs),
+                     static_cast<unsigned long long>(s.bytes),
+                     s.allocs / calls, s.bytes / calls);
+    }
+}
+
+Scope::Scope(int site) : _previous(tCurrent) {
+    gSites[site].calls.fetch_add(1, std::memory_order_relaxed);
+    tCurrent = site;
+}
+
+Scope::~Scope() {
+    tCurrent = _previous;
+}
+
+} // namespace AllocProfile
+
+#ifdef COUP_ALLOC_PROFILE
+
+//
+// The hook: every global allocation is counted, then served by malloc.
+// Array and nothrow forms forward here by default.
+//
+void* operator new(std::size_t n) {
+    AllocProfile::noteAllocation(n);
+    void* p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t n, std::align_val_t align) {
+    AllocProfile::noteAllocation(n);
+    std::size_t a = static_cast<std::size_t>(align);
+    void* p = std::aligned_alloc(a, (n + a - 1) / a * a);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+// Print the table once the program is done.
+struct DumpAtExit {
+    ~DumpAtExit() {
+        std::fprintf(stderr, "\n=== Heap allocations by call site ===\n");
+        AllocProfile::report(stderr);
+    }
+} gDumpAtExit;
+
+} // namespace
+
+#endif
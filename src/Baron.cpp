@@ -1,5 +1,7 @@
 #include "../include/Baron.hpp"
 
+Baron::Baron() = default;
+
 
 
 
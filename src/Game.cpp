@@ -1,62 +1,141 @@
 #include "../include/Game.hpp"
+#include "../include/AllocProfile.hpp"
+#include "../include/ReplayLog.hpp"
 #include <iostream>
 
+namespace {
+
+// Little-endian 32-bit fields of a snapshot.
+void putI32(std::vector<std::uint8_t>& out, std::int32_t v) {
+    std::uint32_t u = static_cast<std::uint32_t>(v);
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(u >> (8 * i)));
+}
+
+std::int32_t getI32(const std::uint8_t* p) {
+    std::uint32_t u = 0;
+    for (int i = 0; i < 4; ++i) u |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+    return static_cast<std::int32_t>(u);
+}
+
+// Attaches the replay writer and the custom-role hooks to the state for
+// one call, so the state's derived events are recorded, Custom seats reach
+// their Player, and copies taken at rest carry neither.
+class CallScope {
+public:
+    CallScope(GameState& state, ReplayWriter* writer, RoleHooks* hooks) : _state(state) {
+        _state.replay = writer;
+        _state.hooks = hooks;
+    }
+    ~CallScope() {
+        _state.replay = nullptr;
+        _state.hooks = nullptr;
+    }
+
+private:
+    GameState& _state;
+};
+
+} // namespace
+
 //
-// Constructor: initialize coin pool to 50 and currentIndex = 0.
+// Constructor: empty state (pool of 50, no seats) and no player handles.
 //
 Game::Game()
-    : _currentIndex(0), _poolCoins(50) {}
+    : _seats{}, _log(nullptr), _replay(nullptr) {}
 
 Game::~Game() = default;
 
 //
-// Add a player to the game.
-// Throws if player pointer is null or name already exists.
+// Add a player to the game: hand out the next seat (the player's id) and
+// move the player's coins into the state. Throws if player pointer is null, belongs to another
+// game, name already exists or the table is full.
 //
 void Game::addPlayer(Player* player) {
+    ALLOC_SITE("Game::addPlayer");
     if (!player) {
         throw IllegalAction("Cannot add null player");
     }
-    for (auto* p : _players) {
-        if (p->name() == player->name()) {
-            throw IllegalAction("Duplicate player name: " + player->name());
-        }
+    if (player->game() != this) {
+        throw IllegalAction("Player " + player->name() + " belongs to another game");
+    }
+    if (idOf(player->name()) != GameState::kNoSeat) {
+        throw IllegalAction("Duplicate player name: " + player->name());
+    }
+    int seat = _state.addSeat(player->roleId(), player->abilities(), player->coins());
+    if (seat == GameState::kNoSeat) {
+        throw IllegalAction("Table is full, cannot add " + player->name());
     }
-    _players.push_back(player);
+    _seats[seat] = player;
+    _ids[player->name()] = seat;
+    player->_seat = seat;
+    if (_log) _log->recordJoin(seat, player->coins());
+    if (_replay) _replay->join(seat, player->roleId(), player->coins());
+}
+
+//
+// Name → id lookup. The index keeps the latest seat per name; it only
+// counts while that seat is still in play (coups remove seats in the state).
+//
+int Game::idOf(const std::string& name) const {
+    auto it = _ids.find(name);
+    if (it == _ids.end() || !_state.isAlive(it->second)) {
+        return GameState::kNoSeat;
+    }
+    return it->second;
+}
+
+void Game::renamePlayer(int seat, const std::string& from, const std::string& to) {
+    auto it = _ids.find(from);
+    if (it != _ids.end() && it->second == seat) {
+        _ids.erase(it);
+    }
+    _ids[to] = seat;
 }
 
 //
 // Return the name of the player whose turn it is.
 // Throws if no players.
 //
-std::string Game::turn() const {
-    if (_players.empty()) {
+const std::string& Game::turn() const {
+    ALLOC_SITE("Game::turn");
+    if (_state.activeCount == 0) {
         throw IllegalAction("No players in game");
     }
-    return _players[_currentIndex]->name();
+    return getCurrentPlayer()->name();
 }
 
 //
 // Advance to the next turn:
 //  1. process any pending actions (Tax, Bribe, Arrest, Sanction, Coup).
 //  2. advance currentIndex (wrap around).
-//  3. call onStartTurn() for the new current player.
+//  3. run the start-of-turn hook for the new current player (from
+//     kRoleRules, or the Player's Role for RoleId::Custom).
 // If no players remain, does nothing.
 //
 void Game::nextTurn() {
-    processPending();
-    if (_players.empty()) return;
-    _currentIndex = (_currentIndex + 1) % _players.size();
-    _players[_currentIndex]->onStartTurn();
+    ALLOC_SITE("Game::nextTurn");
+    if (!_inbox.empty()) drainInbox();
+    if (_replay) _replay->nextTurn();
+    CallScope scope(_state, _replay, this);
+    _state.nextTurn();
 }
 
+//
+// RoleHooks: start-of-turn, arrest and sanction for RoleId::Custom seats
+// go to the seat's Player, which runs its Role's hook.
+//
+void Game::onStartTurn(int seat)  { _seats[seat]->onStartTurn(); }
+void Game::onArrested(int seat)   { _seats[seat]->handleArrested(); }
+void Game::onSanctioned(int seat) { _seats[seat]->handleSanctioned(); }
+
 //
 // Get names of all active players (in join order).
 //
 std::vector<std::string> Game::players() const {
+    ALLOC_SITE("Game::players");
     std::vector<std::string> names;
-    for (auto* p : _players) {
-        names.push_back(p->name());
+    for (int i = 0; i < _state.activeCount; ++i) {
+        names.push_back(_seats[_state.order[i]]->name());
     }
     return names;
 }
@@ -66,20 +145,13 @@ std::vector<std::string> Game::players() const {
 // Throws if not found. Adjusts currentIndex accordingly.
 //
 void Game::removePlayer(Player* player) {
-    auto it = std::find(_players.begin(), _players.end(), player);
-    if (it == _players.end()) {
+    int seat = seatOf(player);
+    if (!_state.isAlive(seat)) {
         throw IllegalAction("Player to remove not found: " + player->name());
     }
-    size_t idx = std::distance(_players.begin(), it);
-    _players.erase(it);
-    if (_players.empty()) {
-        _currentIndex = 0;
-        return;
-    }
-    if (idx < _currentIndex || _currentIndex >= _players.size()) {
-        // If removal was before current index, shift back one.
-        _currentIndex = (_currentIndex == 0) ? 0 : _currentIndex - 1;
-    }
+    if (_replay) _replay->remove(seat);
+    CallScope scope(_state, _replay, this);
+    _state.removePlayer(seat);
 }
 
 //
@@ -87,8 +159,9 @@ void Game::removePlayer(Player* player) {
 // Otherwise throw GameStillActive.
 //
 std::string Game::winner() const {
-    if (_players.size() == 1) {
-        return _players[0]->name();
+    int seat = _state.winner();
+    if (seat != GameState::kNoSeat) {
+        return _seats[seat]->name();
     }
     throw GameStillActive("More than one player remains");
 }
@@ -97,17 +170,17 @@ std::string Game::winner() const {
 // Coin pool (treasury) accessors/mutators.
 //
 int Game::poolCoins() const {
-    return _poolCoins;
+    return _state.pool;
 }
 void Game::takeFromPool(int n) {
-    if (n > _poolCoins) {
+    if (_state.takeFromPool(n) != ActionResult::Ok) {
         throw IllegalAction("Not enough coins in the pool");
     }
-    _poolCoins -= n;
+    if (_replay) _replay->pool(-n);
 }
 void Game::returnToPool(int n) {
-    if (n < 0) return;
-    _poolCoins += n;
+    _state.returnToPool(n);
+    if (_replay && n >= 0) _replay->pool(n);
 }
 
 //
@@ -118,25 +191,51 @@ bool Game::mustCoup(const Player& p) const {
     return p.coins() >= 10;
 }
 
+//
+// Legal-move generation for p (empty if p is not seated or not on turn).
+//
+void Game::legalActions(const Player& p, ActionBuffer& out) const {
+    _state.legalActions(seatOf(&p), out);
+}
+
 //
 // Register pending actions that can be blocked.
-// Simply push them into the _pending vector. These will be resolved
-// in processPending() at the next nextTurn().
+// These are resolved in processPending() at the next nextTurn().
 //
 void Game::registerTax(Player* actor) {
-    _pending.push_back({actor, nullptr, ActionType::Tax});
+    ALLOC_SITE("Game::registerTax");
+    if (_state.registerAction(ActionType::Tax, seatOf(actor), GameState::kNoSeat) != ActionResult::Ok) {
+        throw IllegalAction("Too many pending actions");
+    }
+    if (_replay) _replay->registerAction(ActionType::Tax, seatOf(actor), GameState::kNoSeat);
 }
 void Game::registerBribe(Player* actor) {
-    _pending.push_back({actor, nullptr, ActionType::Bribe});
+    ALLOC_SITE("Game::registerBribe");
+    if (_state.registerAction(ActionType::Bribe, seatOf(actor), GameState::kNoSeat) != ActionResult::Ok) {
+        throw IllegalAction("Too many pending actions");
+    }
+    if (_replay) _replay->registerAction(ActionType::Bribe, seatOf(actor), GameState::kNoSeat);
 }
 void Game::registerArrest(Player* actor, Player* target) {
-    _pending.push_back({actor, target, ActionType::Arrest});
+    ALLOC_SITE("Game::registerArrest");
+    if (_state.registerAction(ActionType::Arrest, seatOf(actor), seatOf(target)) != ActionResult::Ok) {
+        throw IllegalAction("Too many pending actions");
+    }
+    if (_replay) _replay->registerAction(ActionType::Arrest, seatOf(actor), seatOf(target));
 }
 void Game::registerSanction(Player* actor, Player* target) {
-    _pending.push_back({actor, target, ActionType::Sanction});
+    ALLOC_SITE("Game::registerSanction");
+    if (_state.registerAction(ActionType::Sanction, seatOf(actor), seatOf(target)) != ActionResult::Ok) {
+        throw IllegalAction("Too many pending actions");
+    }
+    if (_replay) _replay->registerAction(ActionType::Sanction, seatOf(actor), seatOf(target));
 }
 void Game::registerCoup(Player* actor, Player* target) {
-    _pending.push_back({actor, target, ActionType::Coup});
+    ALLOC_SITE("Game::registerCoup");
+    if (_state.registerAction(ActionType::Coup, seatOf(actor), seatOf(target)) != ActionResult::Ok) {
+        throw IllegalAction("Too many pending actions");
+    }
+    if (_replay) _replay->registerAction(ActionType::Coup, seatOf(actor), seatOf(target));
 }
 
 //
@@ -147,82 +246,389 @@ void Game::registerCoup(Player* actor, Player* target) {
 //  - blockBribe: remove pending Bribe and return 4 coins to pool.
 //  - blockArrest: remove pending Arrest (no coin transfer).
 //  - blockSanction: remove pending Sanction, make offender pay +1 to pool.
-//  - blockCoup: remove pending Coup, offender pays +5 to blocker, return 7 to pool.
+//  - blockCoup: remove pending Coup, blocker pays 5, return 7 to pool.
 //
 void Game::blockTax(Player* blocker, Player* target) {
-    for (auto it = _pending.begin(); it != _pending.end(); ++it) {
-        if (it->type == ActionType::Tax && it->actor == target) {
-            _pending.erase(it);
-            return;
-        }
+    ALLOC_SITE("Game::blockTax");
+    if (_state.blockTax(seatOf(target)) != ActionResult::Ok) {
+        throw IllegalAction("No pending Tax to block on " + target->name());
     }
-    throw IllegalAction("No pending Tax to block on " + target->name());
+    observeBlock(blocker, ActionType::Tax, target);
 }
 
 void Game::blockBribe(Player* blocker, Player* target) {
-    for (auto it = _pending.begin(); it != _pending.end(); ++it) {
-        if (it->type == ActionType::Bribe && it->actor == target) {
-            // Return 4 coins to pool
-            returnToPool(4);
-            _pending.erase(it);
-            return;
-        }
+    ALLOC_SITE("Game::blockBribe");
+    if (_state.blockBribe(seatOf(target)) != ActionResult::Ok) {
+        throw IllegalAction("No pending Bribe to block on " + target->name());
     }
-    throw IllegalAction("No pending Bribe to block on " + target->name());
+    observeBlock(blocker, ActionType::Bribe, target);
 }
 
 void Game::blockArrest(Player* blocker, Player* target) {
-    for (auto it = _pending.begin(); it != _pending.end(); ++it) {
-        if (it->type == ActionType::Arrest && it->target == target) {
-            _pending.erase(it);
-            return;
-        }
+    ALLOC_SITE("Game::blockArrest");
+    if (_state.blockArrest(seatOf(target)) != ActionResult::Ok) {
+        throw IllegalAction("No pending Arrest to block on " + target->name());
     }
-    throw IllegalAction("No pending Arrest to block on " + target->name());
+    observeBlock(blocker, ActionType::Arrest, target);
 }
 
 void Game::blockSanction(Player* blocker, Player* target) {
-    for (auto it = _pending.begin(); it != _pending.end(); ++it) {
-        if (it->type == ActionType::Sanction && it->target == target) {
-            // Offender pays extra 1 coin back to pool
-            it->actor->removeCoins(1);
-            returnToPool(1);
-            _pending.erase(it);
+    ALLOC_SITE("Game::blockSanction");
+    int seat = seatOf(target);
+    int i = _state.findPending(ActionType::Sanction, seat);
+    switch (_state.blockSanction(seat)) {
+        case ActionResult::Ok:
+            observeBlock(blocker, ActionType::Sanction, target);
             return;
-        }
+        case ActionResult::OutOfCoins:
+            throw OutOfCoins("Player \"" + _seats[_state.pending[i].actor]->name()
+                             + "\" cannot remove 1 coins");
+        default:
+            throw IllegalAction("No pending Sanction to block on " + target->name());
     }
-    throw IllegalAction("No pending Sanction to block on " + target->name());
 }
 
 void Game::blockCoup(Player* blocker, Player* target) {
-    for (auto it = _pending.begin(); it != _pending.end(); ++it) {
-        if (it->type == ActionType::Coup && it->target == target) {
-            if (blocker->coins() < 5) {
-                throw OutOfCoins("Need 5 coins to block Coup");
-            }
-            blocker->removeCoins(5);
-            // Return 7 coins to pool since coup is cancelled
-            returnToPool(7);
-            _pending.erase(it);
+    ALLOC_SITE("Game::blockCoup");
+    switch (_state.blockCoup(seatOf(blocker), seatOf(target))) {
+        case ActionResult::Ok:
+            observeBlock(blocker, ActionType::Coup, target);
             return;
+        case ActionResult::OutOfCoins:
+            throw OutOfCoins("Need 5 coins to block Coup");
+        case ActionResult::InvalidPlayer:
+            throw IllegalAction("Blocker is not in this game");
+        default:
+            throw IllegalAction("No pending Coup to block on " + target->name());
+    }
+}
+
+//
+// Make / unmake: the journal is attached to the state only while the move
+// runs, so every write the rules engine makes for it is logged and nothing
+// else is.
+//
+ActionResult Game::apply(const Action& action) {
+    ALLOC_SITE("Game::apply");
+    int seat = _state.currentSeat();
+    if (seat == GameState::kNoSeat) {
+        return ActionResult::NotYourTurn;
+    }
+    _undo.mark();
+    _state.journal = &_undo;
+    ActionResult r = play(seat, action, true);
+    _state.journal = nullptr;
+    if (r != ActionResult::Ok) {
+        _undo.rollback(&_state);
+    }
+    return r;
+}
+
+//
+// Each action goes through act() for the current seat, so rule checks and
+// resolution are the same as for the Player methods.
+//
+Game::BatchResult Game::applyBatch(const Action* actions, std::size_t count) {
+    ALLOC_SITE("Game::applyBatch");
+    for (std::size_t i = 0; i < count; ++i) {
+        int seat = _state.currentSeat();
+        if (seat == GameState::kNoSeat) {
+            return {i, ActionResult::NotYourTurn};
+        }
+        ActionResult r = act(seat, actions[i]);
+        if (r != ActionResult::Ok) {
+            return {i, r};
         }
     }
-    throw IllegalAction("No pending Coup to block on " + target->name());
+    return {count, ActionResult::Ok};
+}
+
+//
+// Blocks reuse runCommand(), the path of a posted block: the pending
+// action is cancelled now and the turn does not move.
+//
+Game::BatchResult Game::applySteps(const BatchStep* steps, std::size_t count) {
+    ALLOC_SITE("Game::applySteps");
+    for (std::size_t i = 0; i < count; ++i) {
+        const BatchStep& step = steps[i];
+        ActionResult r;
+        if (step.kind == BatchStep::Block) {
+            if (!playerAt(step.blocker) || !playerAt(step.action.target)) {
+                return {i, ActionResult::InvalidPlayer};
+            }
+            r = runCommand({InboxCommand::Block, step.action.type, static_cast<std::int8_t>(step.blocker),
+                            static_cast<std::int8_t>(step.action.target), 0});
+        } else {
+            int seat = _state.currentSeat();
+            r = seat == GameState::kNoSeat ? ActionResult::NotYourTurn : act(seat, step.action);
+        }
+        if (r != ActionResult::Ok) {
+            return {i, r};
+        }
+    }
+    return {count, ActionResult::Ok};
+}
+
+bool Game::undo() {
+    if (!_undo.rollback(&_state)) {
+        return false;
+    }
+    if (_replay) _replay->undo();
+    return true;
+}
+
+//
+// GameState::apply, split so that the replay records the action once it
+// is known to be legal and before the resolutions and turn change it
+// causes.
+//
+ActionResult Game::play(int seat, const Action& action, bool undoable) {
+    ActionResult r = _state.declare(seat, action);
+    if (r != ActionResult::Ok) {
+        return r;
+    }
+    if (_replay) _replay->act(seat, action, undoable);
+    if (action.type != ActionType::Bribe) {
+        CallScope scope(_state, _replay, this);
+        _state.nextTurn();
+    }
+    return r;
+}
+
+//
+// Observation feed: Player actions and blocks are logged only once they
+// have succeeded.
+//
+ActionResult Game::act(int seat, const Action& action) {
+    ActionResult r = play(seat, action, false);
+    if (r == ActionResult::Ok && _log) {
+        _log->recordAction(seat, action);
+    }
+    return r;
+}
+
+//
+// A declared action is replayed as its cost and its registration, which
+// is what it did; the resolution comes with the nextTurn() that follows.
+//
+ActionResult Game::declare(int seat, const Action& action) {
+    ALLOC_SITE("Game::declare");
+    if (seat == GameState::kNoSeat || seat != _state.currentSeat()) {
+        return ActionResult::NotYourTurn;
+    }
+    const int before = _state.coins[seat];
+    ActionResult r = _state.declare(seat, action);
+    if (r != ActionResult::Ok) {
+        return r;
+    }
+    if (_replay) {
+        if (_state.coins[seat] != before) _replay->coins(seat, _state.coins[seat] - before);
+        if (action.type != ActionType::Gather) {
+            const bool targeted = action.type == ActionType::Arrest || action.type == ActionType::Sanction
+                               || action.type == ActionType::Coup;
+            _replay->registerAction(action.type, seat, targeted ? action.target : GameState::kNoSeat);
+        }
+    }
+    if (_log) _log->recordAction(seat, action);
+    return r;
+}
+
+//
+// Inbox commands run the checked state calls directly, so a rejected
+// command costs no exception: a Register is a declare() by the current
+// player, a Block goes through GameState::block().
+//
+ActionResult Game::runCommand(const InboxCommand& command) {
+    const ActionType type = command.type;
+    const int seat = command.seat;
+    const int target = command.target;
+    if (type == ActionType::Gather) {
+        return ActionResult::NotAllowed;
+    }
+    const bool needsTarget = command.kind == InboxCommand::Block
+                          || type == ActionType::Arrest || type == ActionType::Sanction
+                          || type == ActionType::Coup;
+    if (!playerAt(seat) || (needsTarget ? !playerAt(target) : target != GameState::kNoSeat)) {
+        return ActionResult::InvalidPlayer;
+    }
+
+    if (command.kind == InboxCommand::Register) {
+        return declare(seat, {type, target});
+    }
+
+    ActionResult r = _state.block(seat, type, target);
+    if (r == ActionResult::Ok) {
+        observeBlock(_seats[seat], type, _seats[target]);
+    }
+    return r;
+}
+
+void Game::observeBlock(Player* blocker, ActionType type, Player* target) {
+    if (_log) {
+        _log->recordBlock(seatOf(blocker), type, seatOf(target));
+    }
+    if (_replay) {
+        _replay->block(type, seatOf(blocker), seatOf(target));
+    }
+}
+
+//
+// Return the Player registered at a seat, or nullptr.
+//
+Player* Game::playerAt(int seat) const {
+    if (seat < 0 || seat >= _state.seatCount) return nullptr;
+    return _seats[seat];
+}
+
+//
+// Snapshots: see Game.hpp for the layout. Seats never exceed a byte and the
+// pending slots are stored as is, so the index over them is rebuilt on load.
+//
+std::vector<std::uint8_t> Game::snapshot() const {
+    std::vector<std::uint8_t> out;
+    out.reserve(9 + 8 * _state.seatCount + _state.activeCount + 4 * _state.pendingCount);
+    out.push_back(kSnapshotVersion);
+    out.push_back(_state.seatCount);
+    out.push_back(_state.activeCount);
+    out.push_back(_state.currentIndex);
+    out.push_back(_state.pendingCount);
+    putI32(out, _state.pool);
+    for (int seat = 0; seat < _state.seatCount; ++seat) {
+        const std::string& name = _seats[seat]->name();
+        if (name.size() > 255) {
+            throw IllegalAction("Player name too long for a snapshot: " + name);
+        }
+        out.push_back(static_cast<std::uint8_t>(_state.roles[seat]));
+        out.push_back(_state.abilities[seat]);
+        putI32(out, _state.coins[seat]);
+        out.push_back(static_cast<std::uint8_t>(name.size()));
+        out.insert(out.end(), name.begin(), name.end());
+    }
+    for (int i = 0; i < _state.activeCount; ++i) {
+        out.push_back(static_cast<std::uint8_t>(_state.order[i]));
+    }
+    for (int slot = 0; slot < _state.pendingCount; ++slot) {
+        const GameState::PendingAction& pa = _state.pending[slot];
+        out.push_back(static_cast<std::uint8_t>(pa.type));
+        out.push_back(static_cast<std::uint8_t>(pa.actor));
+        out.push_back(static_cast<std::uint8_t>(pa.target));
+        out.push_back(pa.blocked ? 1 : 0);
+    }
+    return out;
+}
+
+//
+// Decode into a fresh GameState first, so a bad blob changes nothing; then
+// swap it in and rebind the seats' Player handles.
+//
+void Game::restore(const std::uint8_t* data, std::size_t size) {
+    const std::uint8_t* const end = data + size;
+    const std::uint8_t* p = data;
+    auto need = [&](std::size_t n) {
+        if (static_cast<std::size_t>(end - p) < n) {
+            throw IllegalAction("Snapshot is truncated");
+        }
+    };
+
+    need(9);
+    if (p[0] != kSnapshotVersion) {
+        throw IllegalAction("Unknown snapshot version " + std::to_string(p[0]));
+    }
+    GameState next;
+    next.seatCount = p[1];
+    next.activeCount = p[2];
+    next.currentIndex = p[3];
+    next.pendingCount = p[4];
+    next.pool = getI32(p + 5);
+    p += 9;
+    if (next.seatCount != _state.seatCount) {
+        throw IllegalAction("Snapshot has " + std::to_string(next.seatCount) + " seats, game has "
+                            + std::to_string(_state.seatCount));
+    }
+    if (next.activeCount > next.seatCount || next.pendingCount > GameState::kMaxPending
+        || (next.activeCount > 0 && next.currentIndex >= next.activeCount)) {
+        throw IllegalAction("Snapshot has an invalid table");
+    }
+
+    const char* names[GameState::kMaxPlayers];
+    std::size_t nameSizes[GameState::kMaxPlayers];
+    for (int seat = 0; seat < next.seatCount; ++seat) {
+        need(7);
+        if (p[0] > static_cast<std::uint8_t>(RoleId::Custom)) {
+            throw IllegalAction("Snapshot has an unknown role");
+        }
+        next.roles[seat] = static_cast<RoleId>(p[0]);
+        next.abilities[seat] = p[1];
+        next.coins[seat] = getI32(p + 2);
+        nameSizes[seat] = p[6];
+        p += 7;
+        need(nameSizes[seat]);
+        names[seat] = reinterpret_cast<const char*>(p);
+        p += nameSizes[seat];
+        if (next.roles[seat] == RoleId::Custom && _seats[seat]->roleId() != RoleId::Custom) {
+            throw IllegalAction("Snapshot seat " + std::to_string(seat) + " needs a custom role");
+        }
+    }
+    need(next.activeCount);
+    for (int i = 0; i < next.activeCount; ++i) {
+        int seat = p[i];
+        if (seat >= next.seatCount || ((next.alive >> seat) & 1u)) {
+            throw IllegalAction("Snapshot has an invalid turn order");
+        }
+        next.order[i] = static_cast<std::int8_t>(seat);
+        next.alive |= 1u << seat;
+    }
+    p += next.activeCount;
+    need(4 * static_cast<std::size_t>(next.pendingCount));
+    for (int slot = 0; slot < next.pendingCount; ++slot, p += 4) {
+        int actor = static_cast<std::int8_t>(p[1]);
+        int target = static_cast<std::int8_t>(p[2]);
+        if (p[0] > static_cast<std::uint8_t>(ActionType::Coup) || p[3] > 1
+            || actor < GameState::kNoSeat || actor >= next.seatCount
+            || target < GameState::kNoSeat || target >= next.seatCount) {
+            throw IllegalAction("Snapshot has an invalid pending action");
+        }
+        next.pending[slot] = GameState::PendingAction{static_cast<ActionType>(p[0]),
+                                                      static_cast<std::int8_t>(actor),
+                                                      static_cast<std::int8_t>(target), -1, p[3] == 1};
+    }
+    if (p != end) {
+        throw IllegalAction("Snapshot has trailing bytes");
+    }
+    next.relinkPending();
+    next.rehash();
+
+    _state = next;
+    _undo.clear();
+    _ids.clear();
+    for (int seat = 0; seat < next.seatCount; ++seat) {
+        Player* player = _seats[seat];
+        player->_name.assign(names[seat], nameSizes[seat]);
+        if (next.roles[seat] != RoleId::Custom) {
+            player->_role = Role::flyweight(next.roles[seat]);
+            player->_roleId = next.roles[seat];
+            player->_owned.reset();
+        }
+        _ids[player->_name] = seat;
+    }
 }
 
 //
 // Return the Player* whose turn it is, or nullptr if no players.
 //
 Player* Game::getCurrentPlayer() const {
-    if (_players.empty()) return nullptr;
-    return _players[_currentIndex];
+    int seat = _state.currentSeat();
+    return seat == GameState::kNoSeat ? nullptr : _seats[seat];
 }
 
 //
-// Returns true if p is still in the active _players list.
+// Seat of p in this game, or kNoSeat if p was never added here.
 //
-bool Game::isActive(Player* p) const {
-    return std::find(_players.begin(), _players.end(), p) != _players.end();
+int Game::seatOf(const Player* p) const {
+    if (!p || p->_game != this) {
+        return GameState::kNoSeat;
+    }
+    return p->_seat;
 }
 
 //
@@ -230,70 +636,12 @@ bool Game::isActive(Player* p) const {
 // Any action not removed by a corresponding blockX() is finalized here:
 //  - Tax: actor gains 2 coins (3 if Governor).
 //  - Bribe: actor retains turn (decrement currentIndex to remain on same player).
-//  - Arrest: steal 1 coin (2 if Merchant), call target->handleArrested().
-//  - Sanction: if target has ≥1 coin, remove 1, return to pool; if target is Baron, call target->handleSanctioned().  
-//  - Coup: if target still active, remove them (calls removePlayer); else return 7 coins to pool.
+//  - Arrest: steal 1 coin (2 if Merchant), then the target's onArrested hook.
+//  - Sanction: if target has ≥1 coin, remove 1, return to pool; Baron gets +1 back.
+//  - Coup: if target still active, remove them; else return 7 coins to pool.
+//
 void Game::processPending() {
-    // Copy pending list so we can clear _pending immediately
-    std::vector<PendingAction> toProcess = _pending;
-    _pending.clear();
-
-    for (auto& pa : toProcess) {
-        switch (pa.type) {
-            case ActionType::Gather:
-                pa.actor->addCoins(1);
-                break;
-            case ActionType::Tax: {
-                // Grant coins to actor: 3 if Governor, else 2
-                if (pa.actor->roleName() == "Governor") {
-                    pa.actor->addCoins(3);
-                } else {
-                    pa.actor->addCoins(2);
-                }
-                break;
-            }
-
-            case ActionType::Bribe: {
-                // Extra turn: keep actor as current player
-                if (pa.actor == getCurrentPlayer()) {
-                    if (_currentIndex > 0) _currentIndex--;
-                    else _currentIndex = _players.size() - 1;
-                }
-                break;
-            }
-
-            case ActionType::Arrest: {
-                if (!isActive(pa.actor) || !isActive(pa.target)) break;
-                int stolen = 1;
-                if (pa.target->roleName() == "Merchant") stolen = 2;
-                if (pa.target->coins() < stolen) stolen = pa.target->coins();
-                pa.target->removeCoins(stolen);
-                pa.actor->addCoins(stolen);
-                pa.target->handleArrested();
-                break;
-            }
-
-            case ActionType::Sanction: {
-                if (!isActive(pa.actor) || !isActive(pa.target)) break;
-                if (pa.target->coins() > 0) {
-                    pa.target->removeCoins(1);
-                    returnToPool(1);
-                }
-                if (pa.target->roleName() == "Baron") {
-                    pa.target->handleSanctioned();
-                }
-                break;
-            }
-
-            case ActionType::Coup: {
-                if (isActive(pa.target)) {
-                    removePlayer(pa.target);
-                } else {
-                    // If target was already removed, return 7 coins to pool
-                    returnToPool(7);
-                }
-                break;
-            }
-        }
-    }
+    ALLOC_SITE("Game::processPending");
+    CallScope scope(_state, _replay, this);
+    _state.processPending();
 }
@@ -0,0 +1,544 @@
+#include "../include/GameState.hpp"
+#include "../include/ActionBuffer.hpp"
+#include "../include/UndoJournal.hpp"
+#include "../include/ReplayLog.hpp"
+#include <cstring>
+
+namespace {
+
+// Zobrist feature numbers; per-seat and per-slot features add the index.
+constexpr std::uint32_t kHashCoins   = 0;
+constexpr std::uint32_t kHashRole    = 32;
+constexpr std::uint32_t kHashAlive   = 64;
+constexpr std::uint32_t kHashIndex   = 96;
+constexpr std::uint32_t kHashPool    = 97;
+constexpr std::uint32_t kHashPending = 128;
+
+// Key for (feature, value). Coin counts are unbounded, so a splitmix64 mix
+// of the pair stands in for a table of random numbers.
+std::uint64_t zobrist(std::uint32_t feature, std::uint32_t value) {
+    std::uint64_t z = ((static_cast<std::uint64_t>(feature) << 32) | value) + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// The hashed part of a pending slot (the chain link is derived data).
+std::uint32_t packPending(const GameState::PendingAction& pa) {
+    return static_cast<std::uint32_t>(pa.type)
+         | static_cast<std::uint32_t>(static_cast<std::uint8_t>(pa.actor)) << 8
+         | static_cast<std::uint32_t>(static_cast<std::uint8_t>(pa.target)) << 16
+         | static_cast<std::uint32_t>(pa.blocked) << 24;
+}
+
+} // namespace
+
+//
+// Constructor: empty table, pool of 50, no pending actions.
+//
+GameState::GameState() {
+    std::memset(this, 0, sizeof(*this));
+    std::memset(pendingHead, -1, sizeof(pendingHead));
+    std::memset(pendingTail, -1, sizeof(pendingTail));
+    pool = kStartingPool;
+    hash = computeHash();
+}
+
+//
+// Seats
+//
+int GameState::addSeat(RoleId role, std::uint8_t abil, int startCoins) {
+    if (seatCount >= kMaxPlayers) {
+        return kNoSeat;
+    }
+    int seat = seatCount;
+    set(seatCount, seat + 1);
+    set(coins[seat], startCoins);
+    set(roles[seat], role);
+    set(abilities[seat], abil);
+    set(alive, alive | (1u << seat));
+    set(hash, hash ^ zobrist(kHashCoins + seat, startCoins)
+                   ^ zobrist(kHashRole + seat, static_cast<std::uint32_t>(role))
+                   ^ zobrist(kHashAlive + seat, 1));
+    set(order[activeCount], seat);
+    set(activeCount, activeCount + 1);
+    return seat;
+}
+
+void GameState::setRole(int seat, RoleId role, std::uint8_t abil) {
+    set(hash, hash ^ zobrist(kHashRole + seat, static_cast<std::uint32_t>(roles[seat]))
+                   ^ zobrist(kHashRole + seat, static_cast<std::uint32_t>(role)));
+    set(roles[seat], role);
+    set(abilities[seat], abil);
+}
+
+void GameState::logWrite(const void* field, std::size_t size) {
+    journal->record(this, field, size);
+}
+
+//
+// Remove a seat from the turn order. If removal was before the current
+// index (or the index fell off the end), shift the index back one.
+//
+ActionResult GameState::removePlayer(int seat) {
+    if (!isAlive(seat)) {
+        return ActionResult::InvalidPlayer;
+    }
+    int idx = 0;
+    while (order[idx] != seat) ++idx;
+    for (int i = idx; i + 1 < activeCount; ++i) {
+        set(order[i], order[i + 1]);
+    }
+    set(activeCount, activeCount - 1);
+    setAlive(seat, false);
+    if (replay) replay->removed(seat);
+    if (activeCount == 0) {
+        setCurrentIndex(0);
+        return ActionResult::Ok;
+    }
+    if (idx < currentIndex || currentIndex >= activeCount) {
+        setCurrentIndex((currentIndex == 0) ? 0 : currentIndex - 1);
+    }
+    return ActionResult::Ok;
+}
+
+//
+// Hashed field writes. Each one swaps the field's old feature key for the
+// new one in hash, then writes the field.
+//
+void GameState::setCoins(int seat, int n) {
+    set(hash, hash ^ zobrist(kHashCoins + seat, coins[seat]) ^ zobrist(kHashCoins + seat, n));
+    set(coins[seat], n);
+}
+
+void GameState::setPool(int n) {
+    set(hash, hash ^ zobrist(kHashPool, pool) ^ zobrist(kHashPool, n));
+    set(pool, n);
+}
+
+void GameState::setCurrentIndex(int index) {
+    set(hash, hash ^ zobrist(kHashIndex, currentIndex) ^ zobrist(kHashIndex, index));
+    set(currentIndex, index);
+}
+
+void GameState::setAlive(int seat, bool on) {
+    if (((alive >> seat) & 1u) == static_cast<std::uint32_t>(on)) return;
+    set(hash, hash ^ zobrist(kHashAlive + seat, 1));
+    set(alive, on ? (alive | (1u << seat)) : (alive & ~(1u << seat)));
+}
+
+// Fill a fresh slot (slot == pendingCount before the append).
+void GameState::setPending(int slot, const PendingAction& pa) {
+    set(hash, hash ^ zobrist(kHashPending + slot, packPending(pa)));
+    set(pending[slot], pa);
+}
+
+void GameState::setBlocked(int slot) {
+    PendingAction pa = pending[slot];
+    pa.blocked = true;
+    set(hash, hash ^ zobrist(kHashPending + slot, packPending(pending[slot]))
+                   ^ zobrist(kHashPending + slot, packPending(pa)));
+    set(pending[slot].blocked, true);
+}
+
+std::uint64_t GameState::computeHash() const {
+    std::uint64_t h = zobrist(kHashIndex, currentIndex) ^ zobrist(kHashPool, pool);
+    for (int seat = 0; seat < seatCount; ++seat) {
+        h ^= zobrist(kHashCoins + seat, coins[seat]);
+        h ^= zobrist(kHashRole + seat, static_cast<std::uint32_t>(roles[seat]));
+        if ((alive >> seat) & 1u) h ^= zobrist(kHashAlive + seat, 1);
+    }
+    for (int slot = 0; slot < pendingCount; ++slot) {
+        h ^= zobrist(kHashPending + slot, packPending(pending[slot]));
+    }
+    return h;
+}
+
+//
+// Coins and pool
+//
+void GameState::addCoins(int seat, int n) {
+    if (n < 0) return;
+    setCoins(seat, coins[seat] + n);
+}
+
+ActionResult GameState::removeCoins(int seat, int n) {
+    if (n > coins[seat]) {
+        return ActionResult::OutOfCoins;
+    }
+    setCoins(seat, coins[seat] - n);
+    return ActionResult::Ok;
+}
+
+ActionResult GameState::takeFromPool(int n) {
+    if (n > pool) {
+        return ActionResult::PoolEmpty;
+    }
+    setPool(pool - n);
+    return ActionResult::Ok;
+}
+
+void GameState::returnToPool(int n) {
+    if (n < 0) return;
+    setPool(pool + n);
+}
+
+//
+// Pending actions: append-only slots plus a (type, key seat) index of
+// FIFO chains, so registering and blocking are O(1).
+//
+namespace {
+bool keyedByActor(ActionType type) {
+    return type == ActionType::Tax || type == ActionType::Bribe;
+}
+} // namespace
+
+ActionResult GameState::registerAction(ActionType type, int actor, int target) {
+    if (actor < kNoSeat || actor >= kMaxPlayers || target < kNoSeat || target >= kMaxPlayers) {
+        return ActionResult::InvalidPlayer;
+    }
+    if (pendingCount >= kMaxPending) {
+        return ActionResult::TableFull;
+    }
+    int slot = pendingCount;
+    set(pendingCount, slot + 1);
+    setPending(slot, PendingAction{type, static_cast<std::int8_t>(actor),
+                                   static_cast<std::int8_t>(target), -1, false});
+    int t = static_cast<int>(type);
+    int k = keyOf(keyedByActor(type) ? actor : target);
+    if (pendingTail[t][k] >= 0) {
+        set(pending[pendingTail[t][k]].next, slot);
+    } else {
+        set(pendingHead[t][k], slot);
+    }
+    set(pendingTail[t][k], slot);
+    return ActionResult::Ok;
+}
+
+void GameState::relinkPending() {
+    std::memset(pendingHead, -1, sizeof(pendingHead));
+    std::memset(pendingTail, -1, sizeof(pendingTail));
+    for (int slot = 0; slot < pendingCount; ++slot) {
+        PendingAction& pa = pending[slot];
+        pa.next = -1;
+        if (pa.blocked) continue;
+        int t = static_cast<int>(pa.type);
+        int k = keyOf(keyedByActor(pa.type) ? pa.actor : pa.target);
+        if (pendingTail[t][k] >= 0) {
+            pending[pendingTail[t][k]].next = static_cast<std::int8_t>(slot);
+        } else {
+            pendingHead[t][k] = static_cast<std::int8_t>(slot);
+        }
+        pendingTail[t][k] = static_cast<std::int8_t>(slot);
+    }
+}
+
+int GameState::findPending(ActionType type, int seat) const {
+    if (seat < kNoSeat || seat >= kMaxPlayers) return -1;
+    return pendingHead[static_cast<int>(type)][keyOf(seat)];
+}
+
+void GameState::popPending(int slot) {
+    const PendingAction& pa = pending[slot];
+    int t = static_cast<int>(pa.type);
+    int k = keyOf(keyedByActor(pa.type) ? pa.actor : pa.target);
+    set(pendingHead[t][k], pa.next);
+    if (pa.next < 0) set(pendingTail[t][k], -1);
+    setBlocked(slot);
+}
+
+//
+// Blocking: remove the matching pending action and apply any compensation.
+//
+ActionResult GameState::blockTax(int target) {
+    int i = findPending(ActionType::Tax, target);
+    if (i < 0) return ActionResult::NoPending;
+    popPending(i);
+    return ActionResult::Ok;
+}
+
+ActionResult GameState::blockBribe(int target) {
+    int i = findPending(ActionType::Bribe, target);
+    if (i < 0) return ActionResult::NoPending;
+    returnToPool(4);
+    popPending(i);
+    return ActionResult::Ok;
+}
+
+ActionResult GameState::blockArrest(int target) {
+    int i = findPending(ActionType::Arrest, target);
+    if (i < 0) return ActionResult::NoPending;
+    popPending(i);
+    return ActionResult::Ok;
+}
+
+ActionResult GameState::blockSanction(int target) {
+    int i = findPending(ActionType::Sanction, target);
+    if (i < 0) return ActionResult::NoPending;
+    // Offender pays extra 1 coin back to pool
+    if (removeCoins(pending[i].actor, 1) != ActionResult::Ok) {
+        return ActionResult::OutOfCoins;
+    }
+    returnToPool(1);
+    popPending(i);
+    return ActionResult::Ok;
+}
+
+ActionResult GameState::blockCoup(int blocker, int target) {
+    int i = findPending(ActionType::Coup, target);
+    if (i < 0) return ActionResult::NoPending;
+    if (blocker < 0 || blocker >= seatCount) return ActionResult::InvalidPlayer;
+    if (removeCoins(blocker, 5) != ActionResult::Ok) {
+        return ActionResult::OutOfCoins;
+    }
+    // Return 7 coins to pool since coup is cancelled
+    returnToPool(7);
+    popPending(i);
+    return ActionResult::Ok;
+}
+
+ActionResult GameState::block(int blocker, ActionType type, int target) {
+    if (blocker < 0 || blocker >= seatCount || target < 0 || target >= seatCount) {
+        return ActionResult::InvalidPlayer;
+    }
+    if (!canBlock(roles[blocker], type)) return ActionResult::NotAllowed;
+    int i = findPending(type, target);
+    if (i >= 0 && pending[i].actor == blocker) return ActionResult::NotAllowed;
+    switch (type) {
+        case ActionType::Tax:      return blockTax(target);
+        case ActionType::Bribe:    return blockBribe(target);
+        case ActionType::Arrest:   return blockArrest(target);
+        case ActionType::Sanction: return blockSanction(target);
+        case ActionType::Coup:     return blockCoup(blocker, target);
+        default:                   return ActionResult::NotAllowed;
+    }
+}
+
+//
+// Role hooks (onArrested, onSanctioned, onStartTurn), driven by kRoleRules.
+// Custom roles have no row of their own, so they are handed to hooks.
+//
+void GameState::onArrested(int seat) {
+    if (hooks && roles[seat] == RoleId::Custom) {
+        hooks->onArrested(seat);
+        return;
+    }
+    const RoleRules& r = rulesOf(roles[seat]);
+    if (r.arrestPenalty > 0) {
+        removeCoins(seat, coins[seat] >= r.arrestPenalty ? r.arrestPenalty : coins[seat]);
+    }
+    addCoins(seat, r.arrestRefund);
+}
+
+void GameState::onSanctioned(int seat) {
+    if (hooks && roles[seat] == RoleId::Custom) {
+        hooks->onSanctioned(seat);
+        return;
+    }
+    addCoins(seat, rulesOf(roles[seat]).sanctionCompensation);
+}
+
+void GameState::onStartTurn(int seat) {
+    if (hooks && roles[seat] == RoleId::Custom) {
+        hooks->onStartTurn(seat);
+        return;
+    }
+    const RoleRules& r = rulesOf(roles[seat]);
+    if (r.startTurnBonus > 0 && coins[seat] >= r.startTurnThreshold) {
+        addCoins(seat, r.startTurnBonus);
+    }
+}
+
+//
+// Finalize one pending action that was not blocked.
+//
+void GameState::resolve(const PendingAction& pa) {
+    switch (pa.type) {
+        case ActionType::Gather:
+            addCoins(pa.actor, 1);
+            break;
+
+        case ActionType::Tax:
+            addCoins(pa.actor, rulesOf(roles[pa.actor]).taxAmount);
+            break;
+
+        case ActionType::Bribe:
+            // Extra turn: keep actor as current player
+            if (pa.actor == currentSeat()) {
+                setCurrentIndex((currentIndex > 0) ? currentIndex - 1 : activeCount - 1);
+            }
+            break;
+
+        case ActionType::Arrest: {
+            if (!isAlive(pa.actor) || !isAlive(pa.target)) break;
+            int stolen = rulesOf(roles[pa.target]).arrestLoss;
+            if (coins[pa.target] < stolen) stolen = coins[pa.target];
+            removeCoins(pa.target, stolen);
+            addCoins(pa.actor, stolen);
+            onArrested(pa.target);
+            break;
+        }
+
+        case ActionType::Sanction:
+            if (!isAlive(pa.actor) || !isAlive(pa.target)) break;
+            if (coins[pa.target] > 0) {
+                removeCoins(pa.target, 1);
+                returnToPool(1);
+            }
+            onSanctioned(pa.target);
+            break;
+
+        case ActionType::Coup:
+            if (isAlive(pa.target)) {
+                removePlayer(pa.target);
+            } else {
+                // If target was already removed, return 7 coins to pool
+                returnToPool(7);
+            }
+            break;
+    }
+}
+
+//
+// Resolve all pending actions in registration order, in place, skipping
+// tombstones. Nothing registers during resolution, so each slot's index
+// entry can be cleared as it is visited.
+//
+void GameState::processPending() {
+    int count = pendingCount;
+    std::uint64_t slots = 0;
+    set(pendingCount, 0);
+    for (int i = 0; i < count; ++i) {
+        const PendingAction& pa = pending[i];
+        int t = static_cast<int>(pa.type);
+        int k = keyOf(keyedByActor(pa.type) ? pa.actor : pa.target);
+        set(pendingHead[t][k], -1);
+        set(pendingTail[t][k], -1);
+        slots ^= zobrist(kHashPending + i, packPending(pa));
+        if (replay) replay->resolve(pa.type, pa.actor, pa.target, pa.blocked);
+        if (!pa.blocked) resolve(pa);
+    }
+    set(hash, hash ^ slots);
+}
+
+void GameState::nextTurn() {
+    processPending();
+    if (activeCount == 0) return;
+    setCurrentIndex((currentIndex + 1) % activeCount);
+    if (replay) replay->turn(order[currentIndex]);
+    onStartTurn(order[currentIndex]);
+}
+
+//
+// Player actions. Checks run in the same order as in Player so that the
+// first failing rule is reported identically. declare() does everything up
+// to registration; apply() then ends the turn, except after a Bribe, whose
+// unblocked resolution gives the extra turn.
+//
+ActionResult GameState::declare(int seat, const Action& action) {
+    if (seat != currentSeat()) return ActionResult::NotYourTurn;
+    int target = action.target;
+    switch (action.type) {
+        case ActionType::Gather:
+            addCoins(seat, 1);
+            return ActionResult::Ok;
+
+        case ActionType::Tax:
+            if (!can(seat, CanTax)) return ActionResult::NotAllowed;
+            return registerAction(ActionType::Tax, seat, kNoSeat);
+
+        case ActionType::Bribe:
+            if (!can(seat, CanBribe)) return ActionResult::NotAllowed;
+            if (coins[seat] < 4) return ActionResult::OutOfCoins;
+            if (pendingCount >= kMaxPending) return ActionResult::TableFull;
+            setCoins(seat, coins[seat] - 4);
+            return registerAction(ActionType::Bribe, seat, kNoSeat);
+
+        case ActionType::Arrest:
+            if (!can(seat, CanArrest)) return ActionResult::NotAllowed;
+            if (seat == target) return ActionResult::SelfTarget;
+            return registerAction(ActionType::Arrest, seat, target);
+
+        case ActionType::Sanction:
+            if (!can(seat, CanSanction)) return ActionResult::NotAllowed;
+            if (coins[seat] < 3) return ActionResult::OutOfCoins;
+            if (target < kNoSeat || target >= kMaxPlayers) return ActionResult::InvalidPlayer;
+            if (pendingCount >= kMaxPending) return ActionResult::TableFull;
+            setCoins(seat, coins[seat] - 3);
+            return registerAction(ActionType::Sanction, seat, target);
+
+        case ActionType::Coup:
+            if (coins[seat] < 7) return ActionResult::OutOfCoins;
+            if (seat == target) return ActionResult::SelfTarget;
+            if (target < kNoSeat || target >= kMaxPlayers) return ActionResult::InvalidPlayer;
+            if (pendingCount >= kMaxPending) return ActionResult::TableFull;
+            setCoins(seat, coins[seat] - 7);
+            return registerAction(ActionType::Coup, seat, target);
+    }
+    return ActionResult::NotAllowed;
+}
+
+ActionResult GameState::apply(int seat, const Action& action) {
+    ActionResult r = declare(seat, action);
+    if (r == ActionResult::Ok && action.type != ActionType::Bribe) {
+        nextTurn();
+    }
+    return r;
+}
+
+ActionResult GameState::gather(int seat) {
+    return apply(seat, {ActionType::Gather, kNoSeat});
+}
+
+ActionResult GameState::tax(int seat) {
+    return apply(seat, {ActionType::Tax, kNoSeat});
+}
+
+ActionResult GameState::bribe(int seat) {
+    return apply(seat, {ActionType::Bribe, kNoSeat});
+}
+
+ActionResult GameState::arrest(int seat, int target) {
+    return apply(seat, {ActionType::Arrest, target});
+}
+
+ActionResult GameState::sanction(int seat, int target) {
+    return apply(seat, {ActionType::Sanction, target});
+}
+
+ActionResult GameState::coup(int seat, int target) {
+    return apply(seat, {ActionType::Coup, target});
+}
+
+//
+// Legal-move generator: role abilities, coin thresholds and the must-coup
+// rule, in the same terms as the checks above.
+//
+void GameState::legalActions(int seat, ActionBuffer& out) const {
+    out.clear();
+    if (seat == kNoSeat || seat != currentSeat()) return;
+
+    int c = coins[seat];
+    bool canRegister = pendingCount < kMaxPending;
+    if (mustCoup(seat)) {
+        for (int i = 0; canRegister && i < activeCount; ++i) {
+            if (order[i] != seat) out.push(ActionType::Coup, order[i]);
+        }
+        return;
+    }
+
+    out.push(ActionType::Gather, kNoSeat);
+    if (!canRegister) return;
+    if (can(seat, CanTax))             out.push(ActionType::Tax, kNoSeat);
+    if (can(seat, CanBribe) && c >= 4) out.push(ActionType::Bribe, kNoSeat);
+    bool arrest   = can(seat, CanArrest);
+    bool sanction = can(seat, CanSanction) && c >= 3;
+    bool coup     = c >= 7;
+    for (int i = 0; i < activeCount; ++i) {
+        int t = order[i];
+        if (t == seat) continue;
+        if (arrest)   out.push(ActionType::Arrest, t);
+        if (sanction) out.push(ActionType::Sanction, t);
+        if (coup)     out.push(ActionType::Coup, t);
+    }
+}
@@ -1,16 +1,18 @@
 #include "../include/General.hpp"
 
+General::General() = default;
+
 
 /**
  * @brief Implements General’s blockCoup: if there is a pending Coup on target,
  * pay 5 coins to cancel it (return 7 to pool). Throws if insufficient coins or no pending Coup.
  */
-void General::blockCoup(Player& target) {
+void General::blockCoup(Player& self, Player& target) {
     Game* g = target.game();
     if (!g) {
         throw IllegalAction("Game pointer is null");
     }
-    g->blockCoup(this, &target);
+    g->blockCoup(&self, &target);
 }
 
 /**
@@ -1,15 +1,17 @@
 #include "../include/Governor.hpp"
 
+Governor::Governor() = default;
+
 
 
 /**
  * @brief Implements Governor’s blockTax: finds and removes the pending Tax on target.
  * Throws IllegalAction if no such pending Tax.
  */
-void Governor::blockTax(Player& target) {
+void Governor::blockTax(Player& self, Player& target) {
     Game* g = target.game();
     if (!g) {
         throw IllegalAction("Game pointer is null");
     }
-    g->blockTax(this, &target);
+    g->blockTax(&self, &target);
 }
@@ -1,15 +1,17 @@
 #include "../include/Judge.hpp"
 
+Judge::Judge() = default;
+
 /**
  * @brief Implements Judge’s blockBribe: cancels a pending Bribe on target,
  * returning 4 coins to the pool. Throws if no such pending Bribe.
  */
-void Judge::blockBribe(Player& target) {
+void Judge::blockBribe(Player& self, Player& target) {
     Game* g = target.game();
     if (!g) {
         throw IllegalAction("Game pointer is null");
     }
-    g->blockBribe(this, &target);
+    g->blockBribe(&self, &target);
 }
 
 /**
@@ -0,0 +1,58 @@
+#include "../include/MatchArena.hpp"
+#include <cstdint>
+
+//
+// Constructor: one allocation for the whole match; the Game goes first.
+//
+MatchArena::MatchArena(std::size_t bytes)
+    : _block(new unsigned char[bytes]), _capacity(bytes), _top(0),
+      _game(nullptr), _players{}, _roles{}, _playerCount(0) {
+    newGame();
+}
+
+MatchArena::~MatchArena() {
+    destroy();
+}
+
+void MatchArena::reset() {
+    destroy();
+    _top = 0;
+    newGame();
+}
+
+void MatchArena::newGame() {
+    void* mem = allocate(sizeof(Game), alignof(Game));
+    if (!mem) {
+        throw std::bad_alloc();
+    }
+    _game = new (mem) Game();
+}
+
+//
+// Bump allocation: round the top up to align, hand out size bytes.
+//
+void* MatchArena::allocate(std::size_t size, std::size_t align) {
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(_block.get());
+    std::uintptr_t p = (base + _top + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+    if (p + size > base + _capacity) {
+        return nullptr;
+    }
+    _top = p + size - base;
+    return reinterpret_cast<void*>(p);
+}
+
+//
+// Players do not own arena roles, so each custom role is destroyed in
+// place after its player.
+//
+void MatchArena::destroy() {
+    while (_playerCount > 0) {
+        --_playerCount;
+        _players[_playerCount]->~Player();
+        if (_roles[_playerCount]) _roles[_playerCount]->~Role();
+    }
+    if (_game) {
+        _game->~Game();
+        _game = nullptr;
+    }
+}
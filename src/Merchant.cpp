@@ -1,5 +1,7 @@
 #include "../include/Merchant.hpp"
 
+Merchant::Merchant() = default;
+
 /**
  * @brief Called at the start of Merchant’s turn:
  * If they have ≥3 coins, they gain +1 coin automatically.
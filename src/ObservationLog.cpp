@@ -0,0 +1,207 @@
+#include "../include/ObservationLog.hpp"
+#include <climits>
+
+namespace {
+
+constexpr int kRoles = static_cast<int>(RoleId::Custom);
+
+// Roles in mask, restricted to those for which pred holds.
+template <typename Pred>
+std::uint8_t rolesWhere(Pred pred) {
+    std::uint8_t mask = 0;
+    for (int r = 0; r < kRoles; ++r) {
+        if (pred(static_cast<RoleId>(r))) mask |= static_cast<std::uint8_t>(1u << r);
+    }
+    return mask;
+}
+
+// Keep only the allowed roles; an empty result means a custom role, which
+// the table cannot describe, so the mask is left alone.
+void narrow(ObservationLog::Belief& b, std::uint8_t allowed) {
+    if (b.roleMask & allowed) b.roleMask &= allowed;
+}
+
+// Apply a coin delta that depends on the seat's unknown role: delta(rules)
+// over every role still in roleMask gives a range, whose midpoint moves the
+// estimate and whose half-width widens the slack.
+template <typename Delta>
+void shift(ObservationLog::Belief& b, std::uint8_t roleMask, Delta delta) {
+    int lo = INT_MAX, hi = INT_MIN;
+    for (int r = 0; r < kRoles; ++r) {
+        if (!(roleMask & (1u << r))) continue;
+        int d = delta(rulesOf(static_cast<RoleId>(r)));
+        if (d < lo) lo = d;
+        if (d > hi) hi = d;
+    }
+    if (lo > hi) return;
+    b.coins += lo + (hi - lo) / 2;
+    b.slack += (hi - lo + 1) / 2;
+    if (b.coins < 0) b.coins = 0;
+}
+
+void add(ObservationLog::Belief& b, int n) {
+    b.coins += n;
+    if (b.coins < 0) b.coins = 0;
+}
+
+// What a blockable Act (Tax, Arrest, Sanction) did to the estimates that
+// a Block of it takes back: the effects it would have had at resolution.
+struct Effect {
+    ActionType   type;
+    std::int8_t  actor;        // kNoSeat once taken back
+    std::int8_t  target;
+    std::int32_t actorCoins;
+    std::int32_t actorSlack;
+    std::int32_t targetCoins;
+    std::int32_t targetSlack;
+};
+
+void undo(ObservationLog::Belief& b, int coins, int slack) {
+    add(b, -coins);
+    b.slack -= slack;
+    if (b.slack < 0) b.slack = 0;
+}
+
+} // namespace
+
+void ObservationLog::recordJoin(int seat, int coins) {
+    _events.push_back({Event::Join, ActionType::Gather, static_cast<std::int8_t>(seat),
+                       GameState::kNoSeat, coins});
+}
+
+void ObservationLog::recordAction(int actor, const Action& action) {
+    _events.push_back({Event::Act, action.type, static_cast<std::int8_t>(actor),
+                       static_cast<std::int8_t>(action.target), 0});
+}
+
+void ObservationLog::recordBlock(int blocker, ActionType type, int target) {
+    _events.push_back({Event::Block, type, static_cast<std::int8_t>(blocker),
+                       static_cast<std::int8_t>(target), 0});
+}
+
+void ObservationLog::recordReveal(int observer, int target, int coins) {
+    _events.push_back({Event::Reveal, ActionType::Gather, static_cast<std::int8_t>(observer),
+                       static_cast<std::int8_t>(target), coins});
+}
+
+//
+// Replay every event in order. Public events update all beliefs the same
+// way; a Reveal only counts for its own observer.
+//
+void ObservationLog::beliefs(int observer, Belief* out) const {
+    for (int s = 0; s < GameState::kMaxPlayers; ++s) out[s] = {kAnyRole, 0, 0};
+
+    // The last kMaxPending blockable Acts; anything older has resolved
+    Effect effects[GameState::kMaxPending];
+    int effectCount = 0;
+
+    for (const Event& e : _events) {
+        if (e.actor < 0 || e.actor >= GameState::kMaxPlayers) continue;
+        Belief& a = out[e.actor];
+        Belief* t = (e.target >= 0 && e.target < GameState::kMaxPlayers) ? &out[e.target] : nullptr;
+
+        switch (e.kind) {
+            case Event::Join:
+                a = {kAnyRole, e.coins, 0};
+                break;
+
+            case Event::Reveal:
+                if (e.actor == observer && t) {
+                    t->coins = e.coins;
+                    t->slack = 0;
+                }
+                break;
+
+            case Event::Block: {
+                narrow(a, rolesWhere([&](RoleId r) { return GameState::canBlock(r, e.type); }));
+                if (e.type == ActionType::Coup) add(a, -5);
+
+                // The latest matching Act (keyed by actor for Tax, target
+                // otherwise) never resolves: take back what it added
+                const int n = effectCount < GameState::kMaxPending ? effectCount : GameState::kMaxPending;
+                for (int k = 1; k <= n; ++k) {
+                    Effect& f = effects[(effectCount - k) % GameState::kMaxPending];
+                    if (f.actor == GameState::kNoSeat || f.type != e.type
+                        || (e.type == ActionType::Tax ? f.actor : f.target) != e.target) {
+                        continue;
+                    }
+                    undo(out[f.actor], f.actorCoins, f.actorSlack);
+                    if (f.target != GameState::kNoSeat) undo(out[f.target], f.targetCoins, f.targetSlack);
+                    if (e.type == ActionType::Sanction) add(out[f.actor], -1);  // the offender's fine
+                    f.actor = GameState::kNoSeat;
+                    break;
+                }
+                break;
+            }
+
+            case Event::Act: {
+                // The actor's start-of-turn hook ran, unseen, before the action
+                const int c = a.coins;
+                shift(a, a.roleMask, [c](const RoleRules& r) {
+                    return (r.startTurnBonus > 0 && c >= r.startTurnThreshold) ? r.startTurnBonus : 0;
+                });
+                const Belief actorBefore = a;
+                const Belief targetBefore = t ? *t : Belief{kAnyRole, 0, 0};
+
+                switch (e.type) {
+                    case ActionType::Gather:
+                        add(a, 1);
+                        break;
+                    case ActionType::Tax:
+                        narrow(a, rolesWhere([](RoleId r) { return rulesOf(r).canTax; }));
+                        shift(a, a.roleMask, [](const RoleRules& r) { return r.taxAmount; });
+                        break;
+                    case ActionType::Bribe:
+                        narrow(a, rolesWhere([](RoleId r) { return rulesOf(r).canBribe; }));
+                        add(a, -4);
+                        break;
+                    case ActionType::Arrest: {
+                        narrow(a, rolesWhere([](RoleId r) { return rulesOf(r).canArrest; }));
+                        if (!t) break;
+                        const int tc = t->coins;
+                        const std::uint8_t tm = t->roleMask;
+                        shift(a, tm, [tc](const RoleRules& r) {
+                            return r.arrestLoss < tc ? r.arrestLoss : tc;
+                        });
+                        shift(*t, tm, [tc](const RoleRules& r) {
+                            int left = tc - (r.arrestLoss < tc ? r.arrestLoss : tc);
+                            int penalty = r.arrestPenalty < left ? r.arrestPenalty : left;
+                            return left - penalty + r.arrestRefund - tc;
+                        });
+                        break;
+                    }
+                    case ActionType::Sanction: {
+                        narrow(a, rolesWhere([](RoleId r) { return rulesOf(r).canSanction; }));
+                        add(a, -3);
+                        if (!t) break;
+                        const int tc = t->coins;
+                        shift(*t, t->roleMask, [tc](const RoleRules& r) {
+                            return (tc > 0 ? -1 : 0) + r.sanctionCompensation;
+                        });
+                        break;
+                    }
+                    case ActionType::Coup:
+                        add(a, -7);
+                        break;
+                }
+
+                if (e.type == ActionType::Tax || e.type == ActionType::Arrest
+                    || e.type == ActionType::Sanction) {
+                    // A Sanction's cost is paid up front and kept when it is blocked
+                    const bool keep = e.type == ActionType::Sanction;
+                    effects[effectCount++ % GameState::kMaxPending] = {
+                        e.type, e.actor, t ? e.target : static_cast<std::int8_t>(GameState::kNoSeat),
+                        keep ? 0 : a.coins - actorBefore.coins, keep ? 0 : a.slack - actorBefore.slack,
+                        t ? t->coins - targetBefore.coins : 0, t ? t->slack - targetBefore.slack : 0};
+                }
+                break;
+            }
+        }
+    }
+}
+
+ObservationLog::Belief ObservationLog::belief(int observer, int seat) const {
+    Belief all[GameState::kMaxPlayers];
+    beliefs(observer, all);
+    return all[seat];
+}
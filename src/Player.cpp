@@ -1,23 +1,63 @@
 #include "../include/Player.hpp"
+#include "../include/AllocProfile.hpp"
+#include "../include/RoleRegistry.hpp"
 #include <iostream>
 
 //
-// Private helper
+// Constructor
 //
-void Player::ensureMyTurn() const {
-    if (_game->turn() != _name) {
-        throw NotYourTurn("Player \"" + _name + "\" tried to act out of turn");
+Player::Player(const std::string& name, std::unique_ptr<Role> role, Game* game)
+    : _name(name), _coins(0), _role(nullptr), _roleId(RoleId::Custom), _game(game),
+      _seat(GameState::kNoSeat) {
+    if (!game) {
+        throw IllegalAction("Game pointer is null for player " + name);
     }
+    adopt(std::move(role));
 }
 
-//
-// Constructor
-//
-Player::Player(const std::string& name, std::unique_ptr<Role> role, Game* game)
-    : _name(name), _coins(0), _role(std::move(role)), _game(game) {
+Player::Player(const std::string& name, RoleId role, Game* game)
+    : _name(name), _coins(0), _role(Role::flyweight(role)), _roleId(role), _game(game),
+      _seat(GameState::kNoSeat) {
     if (!game) {
         throw IllegalAction("Game pointer is null for player " + name);
     }
+    if (!_role) {
+        throw IllegalAction("No built-in role for player " + name);
+    }
+}
+
+Player::Player(const std::string& name, Role& role, Game* game)
+    : _name(name), _coins(0), _role(&role), _roleId(role.id()), _game(game),
+      _seat(GameState::kNoSeat) {
+    if (!game) {
+        throw IllegalAction("Game pointer is null for player " + name);
+    }
+}
+
+//
+// Role ownership: built-in roles carry no per-player data, so the shared
+// flyweight stands in for them; only custom roles are owned (and cloned).
+//
+void Player::adopt(std::unique_ptr<Role> role) {
+    _roleId = role ? role->id() : RoleId::Custom;
+    if (_roleId != RoleId::Custom) {
+        _role = Role::flyweight(_roleId);
+        _owned.reset();
+    } else {
+        _owned = std::move(role);
+        _role = _owned.get();
+    }
+}
+
+void Player::copyRole(const Player& other) {
+    _roleId = other._roleId;
+    if (_roleId != RoleId::Custom) {
+        _role = other._role;
+        _owned.reset();
+    } else {
+        _owned = other.cloneRole();
+        _role = _owned.get();
+    }
 }
 
 /**
@@ -30,48 +70,111 @@ void Player::specialAction(Player& self, Player& target) {
 }
 
 //
-// Copy constructor — deep-copy the Role
+// Copy constructor — share or clone the Role (see copyRole). The copy is
+// not seated; it keeps its own snapshot of other's coins.
 //
 Player::Player(const Player& other)
     : _name(other._name),
-      _coins(other._coins),
-      _role(other.cloneRole()),
-      _game(other._game) {
+      _coins(other.coins()),
+      _role(nullptr),
+      _roleId(RoleId::Custom),
+      _game(other._game),
+      _seat(GameState::kNoSeat) {
     // Note: _game pointer is shared; logic assumes same Game instance
+    copyRole(other);
 }
 
 //
-// Copy assignment — deep-copy the Role
+// Copy assignment — share or clone the Role. A seated player keeps its seat and
+// takes over other's coin balance there.
 //
 Player& Player::operator=(const Player& other) {
     if (this == &other) return *this;
+    int coins = other.coins();
+    if (_seat != GameState::kNoSeat) {
+        _game->renamePlayer(_seat, _name, other._name);
+    }
     _name = other._name;
-    _coins = other._coins;
-    _role = other.cloneRole();
-    _game = other._game;
+    copyRole(other);
+    if (_seat != GameState::kNoSeat) {
+        GameState& st = _game->state();
+        st.setRole(_seat, roleId(), abilities());
+        st.setCoins(_seat, coins);
+    } else {
+        _coins = coins;
+        _game = other._game;
+    }
     return *this;
 }
 
 //
-// Called by Game at start of this player’s turn.
+// Current coin balance: the seat's balance once added to a Game.
+//
+int Player::coins() const {
+    if (_seat == GameState::kNoSeat) return _coins;
+    return _game->state().coins[_seat];
+}
+
+//
+// Blocks go through the role, which knows whether it may block and asks
+// Game to cancel the pending action with this player as the blocker.
+//
+void Player::blockTax(Player& target)      { _role->blockTax(*this, target); }
+void Player::blockBribe(Player& target)    { _role->blockBribe(*this, target); }
+void Player::blockArrest(Player& target)   { _role->blockArrest(*this, target); }
+void Player::blockSanction(Player& target) { _role->blockSanction(*this, target); }
+void Player::blockCoup(Player& target)     { _role->blockCoup(*this, target); }
+
+//
+// Map the role onto the flat state's RoleId and ability bits. Built-in
+// roles are dispatched on the cached id through RoleRegistry, which calls
+// the concrete (final) class directly; custom roles go through Role. The
+// hooks below dispatch the same way, but Game only calls them for custom
+// roles: built-in effects are resolved in GameState from kRoleRules.
+//
+RoleId Player::roleId() const {
+    return _roleId;
+}
+
+std::uint8_t Player::abilities() const {
+    if (_roleId != RoleId::Custom) {
+        return visitRole(_roleId, [](const auto& r) { return abilityBits(r); });
+    }
+    return abilityBits(*_role);
+}
+
+//
+// Start-of-turn hook (Game calls it for custom roles only).
 //
 void Player::onStartTurn() {
-    _role->onStartTurn(*this);
+    if (_roleId != RoleId::Custom) {
+        visitRole(_roleId, [this](auto& r) { r.onStartTurn(*this); });
+    } else {
+        _role->onStartTurn(*this);
+    }
     // If _coins >= 10, game may force coup, but that’s external logic
 }
 
 //
-// Called by Game when this player is arrested.
+// Arrest hook (Game calls it for custom roles only).
 //
 void Player::handleArrested() {
-    _role->onArrested(*this);
+    if (_roleId != RoleId::Custom) {
+        visitRole(_roleId, [this](auto& r) { r.onArrested(*this); });
+    } else {
+        _role->onArrested(*this);
+    }
 }
 
 //
-// Called by Game when this player is sanctioned.
+// Sanction hook (Game calls it for custom roles only).
 //
 void Player::handleSanctioned() {
-    _role->onSanctioned(*this);
+    if (_roleId != RoleId::Custom) {
+        visitRole(_roleId, [this](auto& r) { r.onSanctioned(*this); });
+    } else {
+        _role->onSanctioned(*this);
+    }
 }
 
 void Player::onSanctioned(Player &p) {
@@ -84,6 +187,11 @@ void Player::onSanctioned(Player &p) {
 //
 void Player::addCoins(int n) {
     if (n < 0) return;
+    if (_seat != GameState::kNoSeat) {
+        _game->state().addCoins(_seat, n);
+        if (_game->_replay) _game->_replay->coins(_seat, n);
+        return;
+    }
     _coins += n;
 }
 
@@ -91,9 +199,14 @@ void Player::addCoins(int n) {
 // Remove coins from this player’s balance. Throws if insufficient.
 //
 void Player::removeCoins(int n) {
-    if (n > _coins) {
+    if (n > coins()) {
         throw OutOfCoins("Player \"" + _name + "\" cannot remove " + std::to_string(n) + " coins");
     }
+    if (_seat != GameState::kNoSeat) {
+        _game->state().removeCoins(_seat, n);
+        if (_game->_replay) _game->_replay->coins(_seat, -n);
+        return;
+    }
     _coins -= n;
 }
 
@@ -101,7 +214,80 @@ void Player::removeCoins(int n) {
 // Change this player’s Role (for future expansions).
 //
 void Player::setRole(std::unique_ptr<Role> newRole) {
-    _role = std::move(newRole);
+    adopt(std::move(newRole));
+    if (_seat != GameState::kNoSeat) {
+        _game->state().setRole(_seat, roleId(), abilities());
+    }
+}
+
+//
+// Seat of another player in this player's game, or kNoSeat.
+//
+int Player::seatOf(const Player& p) const {
+    return p._game == _game ? p._seat : GameState::kNoSeat;
+}
+
+//
+// Turn a rejected action into the matching exception. Strings are only
+// built here, on the failure path.
+//
+void Player::raise(ActionResult result, const char* action, int cost) const {
+    switch (result) {
+        case ActionResult::NotYourTurn:
+            if (_game->state().activeCount == 0) {
+                throw IllegalAction("No players in game");
+            }
+            throw NotYourTurn("Player \"" + _name + "\" tried to act out of turn");
+        case ActionResult::NotAllowed:
+            throw IllegalAction("Role " + _role->name() + " cannot " + action);
+        case ActionResult::OutOfCoins:
+            throw OutOfCoins("Need " + std::to_string(cost) + " coins to " + action);
+        case ActionResult::SelfTarget:
+            throw IllegalAction(std::string("Cannot ") + action + " yourself");
+        case ActionResult::TableFull:
+            throw IllegalAction("Too many pending actions");
+        default:
+            throw IllegalAction(std::string("Cannot ") + action);
+    }
+}
+
+//
+// Non-throwing actions: each forwards to the seat's GameState rules (through
+// Game, which logs successful actions) and returns the result code. An unseated player is never on turn.
+//
+ActionResult Player::tryGather() {
+    if (_seat == GameState::kNoSeat) return ActionResult::NotYourTurn;
+    return _game->act(_seat, {ActionType::Gather, GameState::kNoSeat});
+}
+
+ActionResult Player::tryTax() {
+    if (_seat == GameState::kNoSeat) return ActionResult::NotYourTurn;
+    return _game->act(_seat, {ActionType::Tax, GameState::kNoSeat});
+}
+
+ActionResult Player::tryBribe() {
+    if (_seat == GameState::kNoSeat) return ActionResult::NotYourTurn;
+    return _game->act(_seat, {ActionType::Bribe, GameState::kNoSeat});
+}
+
+ActionResult Player::tryArrest(Player& target) {
+    if (_seat == GameState::kNoSeat) return ActionResult::NotYourTurn;
+    return _game->act(_seat, {ActionType::Arrest, seatOf(target)});
+}
+
+ActionResult Player::trySanction(Player& target) {
+    if (_seat == GameState::kNoSeat) return ActionResult::NotYourTurn;
+    return _game->act(_seat, {ActionType::Sanction, seatOf(target)});
+}
+
+ActionResult Player::tryCoup(Player& target) {
+    if (_seat == GameState::kNoSeat) return ActionResult::NotYourTurn;
+    return _game->act(_seat, {ActionType::Coup, seatOf(target)});
+}
+
+ActionResult Player::tryAction(const Action& action) {
+    if (_seat == GameState::kNoSeat) return ActionResult::NotYourTurn;
+    return _game->act(_seat, action);
 }
 
 //
@@ -109,9 +295,9 @@ void Player::setRole(std::unique_ptr<Role> newRole) {
 // Advances turn.
 //
 void Player::gather() {
-    ensureMyTurn();
-    _coins += 1;
-    _game->nextTurn();
+    ALLOC_SITE("Player::gather");
+    ActionResult r = tryGather();
+    if (r != ActionResult::Ok) raise(r, "gather", 0);
 }
 
 //
@@ -120,12 +306,9 @@ void Player::gather() {
 // Coins (+2 or +3) are awarded in Game::processPending().
 //
 void Player::tax() {
-    ensureMyTurn();
-    if (!_role->canTax()) {
-        throw IllegalAction("Role " + _role->name() + " cannot tax");
-    }
-    _game->registerTax(this);
-    _game->nextTurn();
+    ALLOC_SITE("Player::tax");
+    ActionResult r = tryTax();
+    if (r != ActionResult::Ok) raise(r, "tax", 0);
 }
 
 //
@@ -135,16 +318,9 @@ void Player::tax() {
 // (extra turn). Pending is processed later.
 //
 void Player::bribe() {
-    ensureMyTurn();
-    if (!_role->canBribe()) {
-        throw IllegalAction("Role " + _role->name() + " cannot bribe");
-    }
-    if (_coins < 4) {
-        throw OutOfCoins("Need 4 coins to bribe");
-    }
-    _coins -= 4;
-    _game->registerBribe(this);
-    // Do not call nextTurn(); bribe gives immediate extra turn if not blocked.
+    ALLOC_SITE("Player::bribe");
+    ActionResult r = tryBribe();
+    if (r != ActionResult::Ok) raise(r, "bribe", 4);
 }
 
 //
@@ -153,15 +329,9 @@ void Player::bribe() {
 // happens in Game::processPending(). Self ≠ target.
 //
 void Player::arrest(Player& target) {
-    ensureMyTurn();
-    if (!_role->canArrest()) {
-        throw IllegalAction("Role " + _role->name() + " cannot arrest");
-    }
-    if (this == &target) {
-        throw IllegalAction("Cannot arrest yourself");
-    }
-    _game->registerArrest(this, &target);
-    _game->nextTurn();
+    ALLOC_SITE("Player::arrest");
+    ActionResult r = tryArrest(target);
+    if (r != ActionResult::Ok) raise(r, "arrest", 0);
 }
 
 //
@@ -170,16 +340,9 @@ void Player::arrest(Player& target) {
 // The target loses 1 coin (or Baron receives +1) when processed.
 //
 void Player::sanction(Player& target) {
-    ensureMyTurn();
-    if (!_role->canSanction()) {
-        throw IllegalAction("Role " + _role->name() + " cannot sanction");
-    }
-    if (_coins < 3) {
-        throw OutOfCoins("Need 3 coins to sanction");
-    }
-    _coins -= 3;
-    _game->registerSanction(this, &target);
-    _game->nextTurn();
+    ALLOC_SITE("Player::sanction");
+    ActionResult r = trySanction(target);
+    if (r != ActionResult::Ok) raise(r, "sanction", 3);
 }
 
 //
@@ -188,14 +351,7 @@ void Player::sanction(Player& target) {
 // Removal happens in Game::processPending().
 //
 void Player::coup(Player& target) {
-    ensureMyTurn();
-    if (_coins < 7) {
-        throw OutOfCoins("Need 7 coins to coup");
-    }
-    if (this == &target) {
-        throw IllegalAction("Cannot coup yourself");
-    }
-    _coins -= 7;
-    _game->registerCoup(this, &target);
-    _game->nextTurn();
+    ALLOC_SITE("Player::coup");
+    ActionResult r = tryCoup(target);
+    if (r != ActionResult::Ok) raise(r, "coup", 7);
 }
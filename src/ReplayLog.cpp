@@ -0,0 +1,142 @@
+#include "../include/ReplayLog.hpp"
+#include "../include/GameState.hpp"
+#include <stdexcept>
+
+namespace {
+
+// Seats that may be kNoSeat are shifted by one so they stay unsigned.
+std::uint64_t seatCode(int seat) {
+    return static_cast<std::uint64_t>(seat + 1);
+}
+
+// Zigzag: 0, -1, 1, -2, ... map to 0, 1, 2, 3, ...
+std::uint64_t zigzag(int v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(v) >> 63);
+}
+
+} // namespace
+
+//
+// Open for append; a new (empty) file gets the header.
+//
+ReplayWriter::ReplayWriter(const std::string& path)
+    : _file(std::fopen(path.c_str(), "ab")), _used(0), _written(0) {
+    if (!_file) {
+        throw std::runtime_error("Cannot open replay file " + path);
+    }
+    std::fseek(_file, 0, SEEK_END);
+    if (std::ftell(_file) == 0) {
+        for (char c : Replay::kMagic) _buffer[_used++] = static_cast<unsigned char>(c);
+    }
+}
+
+ReplayWriter::~ReplayWriter() {
+    if (_used > 0) std::fwrite(_buffer, 1, _used, _file);
+    std::fclose(_file);
+}
+
+void ReplayWriter::flush() {
+    if (_used > 0 && std::fwrite(_buffer, 1, _used, _file) != _used) {
+        throw std::runtime_error("Replay write failed");
+    }
+    _written += _used;
+    _used = 0;
+    std::fflush(_file);
+}
+
+//
+// Unsigned LEB128: seven bits per byte, high bit set on all but the last.
+//
+void ReplayWriter::put(std::uint64_t v) {
+    if (_used + 10 > kBufferSize) flush();
+    while (v >= 0x80) {
+        _buffer[_used++] = static_cast<unsigned char>(v | 0x80);
+        v >>= 7;
+    }
+    _buffer[_used++] = static_cast<unsigned char>(v);
+}
+
+void ReplayWriter::beginMatch(std::uint64_t id) {
+    put(Replay::Begin);
+    put(id);
+}
+
+void ReplayWriter::endMatch(const GameState& state) {
+    put(Replay::End);
+    put(seatCode(state.winner()));
+    put(static_cast<std::uint64_t>(state.pool));
+    put(static_cast<std::uint64_t>(state.seatCount));
+    for (int s = 0; s < state.seatCount; ++s) {
+        put(static_cast<std::uint64_t>(state.coins[s]));
+    }
+}
+
+void ReplayWriter::join(int seat, RoleId role, int coins) {
+    put(Replay::Join);
+    put(static_cast<std::uint64_t>(seat));
+    put(static_cast<std::uint64_t>(role));
+    put(static_cast<std::uint64_t>(coins));
+}
+
+void ReplayWriter::act(int seat, const Action& action, bool undoable) {
+    put(undoable ? Replay::Apply : Replay::Act);
+    put(static_cast<std::uint64_t>(seat));
+    put(static_cast<std::uint64_t>(action.type));
+    put(seatCode(action.target));
+}
+
+void ReplayWriter::registerAction(ActionType type, int actor, int target) {
+    put(Replay::Register);
+    put(static_cast<std::uint64_t>(type));
+    put(seatCode(actor));
+    put(seatCode(target));
+}
+
+void ReplayWriter::block(ActionType type, int blocker, int target) {
+    put(Replay::Block);
+    put(static_cast<std::uint64_t>(type));
+    put(seatCode(blocker));
+    put(seatCode(target));
+}
+
+void ReplayWriter::nextTurn() {
+    put(Replay::NextTurn);
+}
+
+void ReplayWriter::remove(int seat) {
+    put(Replay::Remove);
+    put(static_cast<std::uint64_t>(seat));
+}
+
+void ReplayWriter::undo() {
+    put(Replay::Undo);
+}
+
+void ReplayWriter::coins(int seat, int delta) {
+    put(Replay::Coins);
+    put(static_cast<std::uint64_t>(seat));
+    put(zigzag(delta));
+}
+
+void ReplayWriter::pool(int delta) {
+    put(Replay::Pool);
+    put(zigzag(delta));
+}
+
+void ReplayWriter::resolve(ActionType type, int actor, int target, bool blocked) {
+    put(Replay::Resolve);
+    put(static_cast<std::uint64_t>(type));
+    put(seatCode(actor));
+    put(seatCode(target));
+    put(blocked ? 1 : 0);
+}
+
+void ReplayWriter::turn(int seat) {
+    put(Replay::Turn);
+    put(static_cast<std::uint64_t>(seat));
+}
+
+void ReplayWriter::removed(int seat) {
+    put(Replay::Removed);
+    put(static_cast<std::uint64_t>(seat));
+}
@@ -0,0 +1,298 @@
+#include "../include/ReplayReader.hpp"
+#include "../include/RoleRegistry.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Seat names of a replayed match; short enough to stay in the string itself.
+const std::string kSeatNames[GameState::kMaxPlayers] = {"p0", "p1", "p2", "p3", "p4", "p5"};
+
+int unzigzag(std::uint64_t v) {
+    return static_cast<int>(static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1));
+}
+
+const char* kindName(Replay::Kind kind) {
+    static const char* const kNames[] = {
+        "?", "Begin", "Join", "Act", "Apply", "Register", "Block", "NextTurn", "Remove",
+        "Undo", "Coins", "Pool", "Resolve", "Turn", "Removed", "End"
+    };
+    return kind <= Replay::End ? kNames[kind] : "?";
+}
+
+} // namespace
+
+//
+// Map the whole file read-only; the kernel pages it in as next() walks it.
+//
+ReplayReader::ReplayReader(const std::string& path)
+    : _data(nullptr), _size(0), _pos(sizeof(Replay::kMagic)) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open replay file " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Replay::kMagic)) {
+        ::close(fd);
+        throw std::runtime_error("Not a replay file: " + path);
+    }
+    _size = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("Cannot map replay file " + path);
+    }
+    ::madvise(p, _size, MADV_SEQUENTIAL);
+    _data = static_cast<const unsigned char*>(p);
+    if (std::memcmp(_data, Replay::kMagic, sizeof(Replay::kMagic)) != 0) {
+        ::munmap(p, _size);
+        throw std::runtime_error("Not a replay file (or another format version): " + path);
+    }
+}
+
+ReplayReader::~ReplayReader() {
+    ::munmap(const_cast<unsigned char*>(_data), _size);
+}
+
+std::uint64_t ReplayReader::get() {
+    std::uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (_pos == _size) {
+            throw std::runtime_error("Replay file is truncated");
+        }
+        unsigned char b = _data[_pos++];
+        v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    throw std::runtime_error("Replay file has an overlong varint");
+}
+
+//
+// Decode the fields of one event, in the order ReplayWriter wrote them.
+//
+bool ReplayReader::next(Replay::Event& e) {
+    if (_pos == _size) {
+        return false;
+    }
+    std::uint64_t kind = get();
+    e.kind = static_cast<Replay::Kind>(kind);
+    switch (kind) {
+        case Replay::Begin:
+            e.id = get();
+            break;
+        case Replay::Join:
+            e.seat = static_cast<int>(get());
+            e.role = static_cast<RoleId>(get());
+            e.value = static_cast<int>(get());
+            break;
+        case Replay::Act:
+        case Replay::Apply:
+            e.seat = static_cast<int>(get());
+            e.type = static_cast<ActionType>(get());
+            e.target = getSeat();
+            break;
+        case Replay::Register:
+        case Replay::Block:
+            e.type = static_cast<ActionType>(get());
+            e.seat = getSeat();
+            e.target = getSeat();
+            break;
+        case Replay::NextTurn:
+        case Replay::Undo:
+            break;
+        case Replay::Remove:
+        case Replay::Turn:
+        case Replay::Removed:
+            e.seat = static_cast<int>(get());
+            break;
+        case Replay::Coins:
+            e.seat = static_cast<int>(get());
+            e.value = unzigzag(get());
+            break;
+        case Replay::Pool:
+            e.value = unzigzag(get());
+            break;
+        case Replay::Resolve:
+            e.type = static_cast<ActionType>(get());
+            e.seat = getSeat();
+            e.target = getSeat();
+            e.value = static_cast<int>(get());
+            break;
+        case Replay::End:
+            e.seat = getSeat();
+            e.value = static_cast<int>(get());
+            e.seatCount = static_cast<int>(get());
+            if (e.seatCount > GameState::kMaxPlayers) {
+                throw std::runtime_error("Replay file has an End with too many seats");
+            }
+            for (int s = 0; s < e.seatCount; ++s) {
+                e.coins[s] = static_cast<int>(get());
+            }
+            break;
+        default:
+            throw std::runtime_error("Replay file has an unknown event kind " + std::to_string(kind));
+    }
+    return true;
+}
+
+//
+// One match: skip to its Begin, replay until the first divergence, then
+// read on to its End so the next run() starts at the following match.
+//
+bool Resimulator::run(ReplayReader& reader, Replay::Verdict& verdict) {
+    Replay::Event e;
+    do {
+        if (!reader.next(e)) {
+            return false;
+        }
+    } while (e.kind != Replay::Begin);
+
+    _arena.reset();
+    verdict.match = e.id;
+    verdict.events = 1;
+    verdict.ok = true;
+    verdict.reason.clear();
+    while (reader.next(e)) {
+        ++verdict.events;
+        if (e.kind == Replay::Begin) {
+            break;
+        }
+        if (e.kind == Replay::End) {
+            if (verdict.ok) {
+                verdict.reason = check(e);
+                verdict.ok = verdict.reason.empty();
+            }
+            return true;
+        }
+        if (verdict.ok) {
+            std::string why = replay(e);
+            if (!why.empty()) {
+                verdict.ok = false;
+                verdict.reason = "event " + std::to_string(verdict.events - 1) + " ("
+                                 + kindName(e.kind) + "): " + why;
+            }
+        }
+    }
+    throw std::runtime_error("Replay of match " + std::to_string(verdict.match) + " has no End");
+}
+
+std::string Resimulator::replay(const Replay::Event& e) {
+    Game& game = _arena.game();
+    try {
+        Player* p = (e.kind == Replay::Join || e.kind == Replay::Pool) ? nullptr : game.playerAt(e.seat);
+        Player* t = game.playerAt(e.target);
+        ActionResult r = ActionResult::Ok;
+        switch (e.kind) {
+            case Replay::Join: {
+                if (e.role >= RoleId::Custom) {
+                    return "custom roles cannot be replayed";
+                }
+                if (e.seat != game.state().seatCount) {
+                    return "joins out of seat order";
+                }
+                Player& joined = visitRole(e.role, [&](const auto& role) -> Player& {
+                    using R = std::decay_t<decltype(role)>;
+                    return _arena.addPlayer<R>(kSeatNames[e.seat]);
+                });
+                if (e.value > 0) joined.addCoins(e.value);
+                return {};
+            }
+            case Replay::Act:
+                if (!p) return "no player at seat " + std::to_string(e.seat);
+                switch (e.type) {
+                    case ActionType::Gather: r = p->tryGather(); break;
+                    case ActionType::Tax:    r = p->tryTax();    break;
+                    case ActionType::Bribe:  r = p->tryBribe();  break;
+                    default:
+                        if (!t) return "no player at target seat " + std::to_string(e.target);
+                        if (e.type == ActionType::Arrest)        r = p->tryArrest(*t);
+                        else if (e.type == ActionType::Sanction) r = p->trySanction(*t);
+                        else                                     r = p->tryCoup(*t);
+                }
+                break;
+            case Replay::Apply:
+                if (e.seat != game.state().currentSeat()) {
+                    return "seat " + std::to_string(e.seat) + " is not the current player";
+                }
+                r = game.apply({e.type, e.target});
+                break;
+            case Replay::Register:
+                if (!p) return "no player at seat " + std::to_string(e.seat);
+                switch (e.type) {
+                    case ActionType::Tax:   game.registerTax(p);   break;
+                    case ActionType::Bribe: game.registerBribe(p); break;
+                    default:
+                        if (!t) return "no player at target seat " + std::to_string(e.target);
+                        if (e.type == ActionType::Arrest)        game.registerArrest(p, t);
+                        else if (e.type == ActionType::Sanction) game.registerSanction(p, t);
+                        else if (e.type == ActionType::Coup)     game.registerCoup(p, t);
+                        else return "Gather cannot be registered";
+                }
+                break;
+            case Replay::Block:
+                if (!p || !t) return "no player at blocker or target seat";
+                switch (e.type) {
+                    case ActionType::Tax:      game.blockTax(p, t);      break;
+                    case ActionType::Bribe:    game.blockBribe(p, t);    break;
+                    case ActionType::Arrest:   game.blockArrest(p, t);   break;
+                    case ActionType::Sanction: game.blockSanction(p, t); break;
+                    case ActionType::Coup:     game.blockCoup(p, t);     break;
+                    default: return "Gather cannot be blocked";
+                }
+                break;
+            case Replay::NextTurn:
+                game.nextTurn();
+                break;
+            case Replay::Remove:
+                if (!p) return "no player at seat " + std::to_string(e.seat);
+                game.removePlayer(p);
+                break;
+            case Replay::Undo:
+                if (!game.undo()) return "nothing to undo";
+                break;
+            case Replay::Coins:
+                if (!p) return "no player at seat " + std::to_string(e.seat);
+                if (e.value >= 0) p->addCoins(e.value);
+                else p->removeCoins(-e.value);
+                break;
+            case Replay::Pool:
+                if (e.value < 0) game.takeFromPool(-e.value);
+                else game.returnToPool(e.value);
+                break;
+            default:
+                // Derived events: the current rules produce their own
+                break;
+        }
+        if (r != ActionResult::Ok) {
+            return "rejected with ActionResult " + std::to_string(static_cast<int>(r));
+        }
+    } catch (const std::exception& ex) {
+        return ex.what();
+    }
+    return {};
+}
+
+std::string Resimulator::check(const Replay::Event& e) {
+    const GameState& s = _arena.game().state();
+    if (e.seatCount != s.seatCount) {
+        return "seat count " + std::to_string(s.seatCount) + ", recorded " + std::to_string(e.seatCount);
+    }
+    if (e.seat != s.winner()) {
+        return "winner seat " + std::to_string(s.winner()) + ", recorded " + std::to_string(e.seat);
+    }
+    if (e.value != s.pool) {
+        return "pool " + std::to_string(s.pool) + ", recorded " + std::to_string(e.value);
+    }
+    for (int seat = 0; seat < s.seatCount; ++seat) {
+        if (e.coins[seat] != s.coins[seat]) {
+            return "coins of seat " + std::to_string(seat) + ": " + std::to_string(s.coins[seat])
+                   + ", recorded " + std::to_string(e.coins[seat]);
+        }
+    }
+    return {};
+}
@@ -0,0 +1,10 @@
+#include "../include/Role.hpp"
+#include "../include/RoleRegistry.hpp"
+
+//
+// The registry owns one instance per built-in role.
+//
+Role* Role::flyweight(RoleId id) {
+    if (id == RoleId::Custom) return nullptr;
+    return visitRole(id, [](Role& r) { return &r; });
+}
@@ -0,0 +1,5 @@
+#include "../include/RoleRegistry.hpp"
+
+RoleVariant makeRoleVariant(RoleId id) {
+    return visitRole(id, [](const auto& r) { return RoleVariant(r); });
+}
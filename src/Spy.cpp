@@ -1,21 +1,24 @@
 #include "../include/Spy.hpp"
 #include <iostream>
 
+Spy::Spy() = default;
+
 
 /**
  * @brief Implements Spy’s blockArrest: finds and removes a pending Arrest on target.
  * Throws IllegalAction if no such pending Arrest.
  */
-void Spy::blockArrest(Player& target) {
+void Spy::blockArrest(Player& self, Player& target) {
     Game* g = target.game();
     if (!g) {
         throw IllegalAction("Game pointer is null");
     }
-    g->blockArrest(this, &target);
+    g->blockArrest(&self, &target);
 }
 
 /**
- * @brief Implements Spy’s specialAction: print target’s coin count to stdout.
+ * @brief Implements Spy’s specialAction: print target’s coin count to stdout
+ * and, if the game keeps an observation log, record what the Spy saw.
  * @param self   The Spy performing the action.
  * @param target The Player whose coins are revealed.
  */
@@ -23,4 +26,8 @@ void Spy::specialAction(Player& self, Player& target) {
     std::cout << "Spy \"" << self.name() << "\" sees that \""
               << target.name() << "\" has "
               << target.coins() << " coins.\n";
+    Game* g = self.game();
+    if (g && g->observationLog() && self.id() != GameState::kNoSeat && target.game() == g) {
+        g->observationLog()->recordReveal(self.id(), target.id(), target.coins());
+    }
 }
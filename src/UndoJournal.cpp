@@ -0,0 +1,39 @@
+#include "../include/UndoJournal.hpp"
+#include <cstring>
+
+void UndoJournal::record(const void* base, const void* field, std::size_t size) {
+    Entry e{};
+    e.offset = static_cast<std::uint16_t>(static_cast<const unsigned char*>(field)
+                                          - static_cast<const unsigned char*>(base));
+    e.size = static_cast<std::uint8_t>(size);
+    std::memcpy(&e.old, field, size);
+    _entries.push_back(e);
+}
+
+void UndoJournal::mark() {
+    _marks.push_back(_entries.size());
+}
+
+//
+// Replay the move's writes newest-first, so a field written twice ends up
+// with the value it had before the first write.
+//
+bool UndoJournal::rollback(void* base) {
+    if (_marks.empty()) {
+        return false;
+    }
+    std::size_t start = _marks.back();
+    _marks.pop_back();
+    unsigned char* bytes = static_cast<unsigned char*>(base);
+    while (_entries.size() > start) {
+        const Entry& e = _entries.back();
+        std::memcpy(bytes + e.offset, &e.old, e.size);
+        _entries.pop_back();
+    }
+    return true;
+}
+
+void UndoJournal::clear() {
+    _entries.clear();
+    _marks.clear();
+}
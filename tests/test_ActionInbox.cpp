@@ -0,0 +1,219 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../include/ActionInbox.hpp"
+#include "../include/MatchArena.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Spy.hpp"
+#include "../include/General.hpp"
+
+namespace {
+
+InboxCommand registerCmd(ActionType type, int seat, int target = GameState::kNoSeat, std::uint32_t tag = 0) {
+    return {InboxCommand::Register, type, static_cast<std::int8_t>(seat), static_cast<std::int8_t>(target), tag};
+}
+
+InboxCommand blockCmd(ActionType type, int blocker, int target, std::uint32_t tag = 0) {
+    return {InboxCommand::Block, type, static_cast<std::int8_t>(blocker), static_cast<std::int8_t>(target), tag};
+}
+
+} // namespace
+
+//
+// Test the queue alone: FIFO order, a full inbox refuses, and cells are
+// reused once popped.
+//
+TEST_CASE("ActionInbox: order and capacity") {
+    ActionInbox inbox;
+    InboxCommand out;
+    CHECK(inbox.empty());
+    CHECK_FALSE(inbox.pop(out));
+
+    for (std::uint32_t i = 0; i < ActionInbox::kCapacity; ++i) {
+        REQUIRE(inbox.push(registerCmd(ActionType::Tax, 0, GameState::kNoSeat, i)));
+    }
+    CHECK_FALSE(inbox.push(registerCmd(ActionType::Tax, 0)));
+
+    for (std::uint32_t i = 0; i < ActionInbox::kCapacity / 2; ++i) {
+        REQUIRE(inbox.pop(out));
+        CHECK(out.tag == i);
+    }
+    for (std::uint32_t i = 0; i < ActionInbox::kCapacity / 2; ++i) {
+        REQUIRE(inbox.push(registerCmd(ActionType::Tax, 0, GameState::kNoSeat, 1000 + i)));
+    }
+    for (std::uint32_t i = ActionInbox::kCapacity / 2; i < ActionInbox::kCapacity; ++i) {
+        REQUIRE(inbox.pop(out));
+        CHECK(out.tag == i);
+    }
+    for (std::uint32_t i = 0; i < ActionInbox::kCapacity / 2; ++i) {
+        REQUIRE(inbox.pop(out));
+        CHECK(out.tag == 1000 + i);
+    }
+    CHECK(inbox.empty());
+}
+
+//
+// Test producers racing each other and the consumer: nothing is lost or
+// duplicated and each producer's commands arrive in the order it sent them.
+//
+TEST_CASE("ActionInbox: many producers, one consumer") {
+    constexpr int kProducers = 4;
+    constexpr std::uint32_t kPerProducer = 50000;
+    ActionInbox inbox;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&inbox, p] {
+            for (std::uint32_t i = 0; i < kPerProducer; ++i) {
+                while (!inbox.push(registerCmd(ActionType::Tax, p, GameState::kNoSeat, i))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::uint32_t next[kProducers] = {};
+    bool inOrder = true;
+    std::uint32_t received = 0;
+    InboxCommand out;
+    while (received < kProducers * kPerProducer) {
+        if (!inbox.pop(out)) continue;
+        inOrder = inOrder && out.tag == next[out.seat];
+        ++next[out.seat];
+        ++received;
+    }
+    for (auto& t : producers) t.join();
+
+    CHECK(inOrder);
+    CHECK(inbox.empty());
+    for (std::uint32_t n : next) CHECK(n == kPerProducer);
+}
+
+//
+// Test that posted commands act like declare() and block*() once the
+// owner drains them, and that nextTurn() drains first.
+//
+TEST_CASE("ActionInbox: posted block lands before the next turn") {
+    MatchArena arena;
+    Player& gov = arena.addPlayer<Governor>("Gov");
+    Player& other = arena.addPlayer<Governor>("Other");
+    Player& gen = arena.addPlayer<General>("Gen");
+    Game& g = arena.game();
+    const int before = gov.coins();
+
+    REQUIRE(g.post(registerCmd(ActionType::Tax, 0)));
+    REQUIRE(g.post(blockCmd(ActionType::Tax, 1, 0)));
+    g.nextTurn();
+    CHECK(gov.coins() == before);
+    CHECK(g.turn() == "Other");
+
+    REQUIRE(g.post(registerCmd(ActionType::Tax, 1)));
+    g.nextTurn();
+    CHECK(other.coins() > before);
+
+    (void)gen;
+}
+
+//
+// Test that bad commands are reported through the callback, not thrown.
+//
+TEST_CASE("ActionInbox: drain reports each outcome") {
+    MatchArena arena;
+    arena.addPlayer<Governor>("Gov");
+    arena.addPlayer<Governor>("Other");
+    Game& g = arena.game();
+
+    g.post(registerCmd(ActionType::Tax, 0, GameState::kNoSeat, 1));
+    g.post(blockCmd(ActionType::Tax, 1, 0, 2));
+    g.post(blockCmd(ActionType::Tax, 1, 0, 3));       // already blocked
+    g.post(registerCmd(ActionType::Coup, 0, 7, 4));   // no such seat
+    g.post(registerCmd(ActionType::Tax, 0, 1, 5));    // Tax has no target
+    g.post(registerCmd(ActionType::Gather, 0, GameState::kNoSeat, 6));
+
+    std::vector<ActionResult> results;
+    std::vector<std::uint32_t> tags;
+    CHECK(g.drainInbox([&](const InboxCommand& c, ActionResult r) {
+        tags.push_back(c.tag);
+        results.push_back(r);
+    }) == 6);
+    CHECK(tags == std::vector<std::uint32_t>{1, 2, 3, 4, 5, 6});
+    CHECK(results == std::vector<ActionResult>{ActionResult::Ok, ActionResult::Ok, ActionResult::NoPending,
+                                               ActionResult::InvalidPlayer, ActionResult::InvalidPlayer,
+                                               ActionResult::NotAllowed});
+    CHECK(g.drainInbox() == 0);
+}
+
+//
+// Test the rules on posted commands: a Register is the current player's
+// declare() (turn, role and cost), a Block needs a role that can block it
+// and may not cancel the blocker's own action.
+//
+TEST_CASE("ActionInbox: commands are held to the rules") {
+    MatchArena arena;
+    Player& gov = arena.addPlayer<Governor>("Gov");
+    arena.addPlayer<Spy>("Spy");
+    arena.addPlayer<General>("Gen");
+    Game& g = arena.game();
+
+    auto run = [&g](const InboxCommand& c) {
+        ActionResult result = ActionResult::Ok;
+        g.post(c);
+        g.drainInbox([&](const InboxCommand&, ActionResult r) { result = r; });
+        return result;
+    };
+
+    CHECK(run(registerCmd(ActionType::Tax, 1)) == ActionResult::NotYourTurn);
+    CHECK(run(registerCmd(ActionType::Arrest, 0, 1)) == ActionResult::NotAllowed);
+    CHECK(run(registerCmd(ActionType::Coup, 0, 1)) == ActionResult::OutOfCoins);
+    CHECK(run(registerCmd(ActionType::Tax, 0)) == ActionResult::Ok);
+
+    CHECK(run(blockCmd(ActionType::Tax, 1, 0)) == ActionResult::NotAllowed);    // a Spy cannot block Tax
+    CHECK(run(blockCmd(ActionType::Tax, 0, 0)) == ActionResult::NotAllowed);    // nor a Governor its own
+    CHECK(run(blockCmd(ActionType::Coup, 1, 2)) == ActionResult::NotAllowed);
+    CHECK(run(blockCmd(ActionType::Coup, 2, 1)) == ActionResult::NoPending);
+
+    g.nextTurn();
+    CHECK(gov.coins() == 3);                          // the Tax went through
+}
+
+//
+// Test a network-style thread posting while the owner drains: every
+// register is followed by its block, so a round resolves to nothing.
+//
+TEST_CASE("ActionInbox: post while the owner drains") {
+    MatchArena arena;
+    Player& gov = arena.addPlayer<Governor>("Gov");
+    Player& other = arena.addPlayer<Governor>("Other");
+    Game& g = arena.game();
+    constexpr int kRounds = 50;
+    constexpr std::size_t kPerRound = GameState::kMaxPending;
+    const int before = gov.coins() + other.coins();
+
+    // Each round, whoever's turn it is taxes and the other Governor blocks
+    std::atomic<int> round{0};
+    std::thread net([&] {
+        for (int r = 0; r < kRounds; ++r) {
+            while (round.load() != r) std::this_thread::yield();
+            for (std::size_t i = 0; i < kPerRound; ++i) {
+                while (!g.post(registerCmd(ActionType::Tax, r % 2))) std::this_thread::yield();
+                while (!g.post(blockCmd(ActionType::Tax, 1 - r % 2, r % 2))) std::this_thread::yield();
+            }
+        }
+    });
+    std::size_t ok = 0;
+    for (int r = 0; r < kRounds; ++r) {
+        std::size_t drained = 0;
+        while (drained < 2 * kPerRound) {
+            drained += g.drainInbox([&](const InboxCommand&, ActionResult res) { ok += res == ActionResult::Ok; });
+        }
+        g.nextTurn();
+        round.store(r + 1);
+    }
+    net.join();
+
+    CHECK(ok == 2 * kPerRound * kRounds);
+    CHECK(gov.coins() + other.coins() == before);
+}
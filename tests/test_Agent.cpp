@@ -0,0 +1,35 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../include/Agent.hpp"
+#include "../include/GameState.hpp"
+
+//
+// Test agent lookup by name.
+//
+TEST_CASE("Agent: makeAgent by name") {
+    CHECK(makeAgent("random") != nullptr);
+    CHECK(makeAgent("heuristic") != nullptr);
+    CHECK(makeAgent("nope") == nullptr);
+}
+
+//
+// Test that self-play runs to completion and stays consistent.
+//
+TEST_CASE("Agent: playOut finishes a six-role match") {
+    GameState s;
+    for (int r = 0; r < static_cast<int>(RoleId::Custom); ++r) {
+        RoleId id = static_cast<RoleId>(r);
+        s.addSeat(id, GameState::abilitiesOf(id), 0);
+    }
+    RandomAgent random;
+    HeuristicAgent heuristic;
+    const Agent* agents[6] = {&heuristic, &random, &heuristic, &random, &heuristic, &random};
+
+    std::mt19937_64 rng(7);
+    PlayoutResult r = playOut(s, agents, rng, 5000);
+    CHECK(r.turns > 0);
+    REQUIRE(r.winner != GameState::kNoSeat);
+    CHECK(s.activeCount == 1);
+    CHECK(s.isAlive(r.winner));
+}
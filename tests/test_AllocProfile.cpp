@@ -0,0 +1,65 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <string>
+#include "../include/AllocProfile.hpp"
+
+//
+// Test attribution: allocations belong to the innermost open scope, and
+// to the unattributed site outside every scope.
+//
+TEST_CASE("AllocProfile: innermost scope is charged") {
+    const int outer = AllocProfile::registerSite("test::outer");
+    const int inner = AllocProfile::registerSite("test::inner");
+    CHECK(AllocProfile::registerSite("test::outer") == outer);
+    CHECK(outer != inner);
+    AllocProfile::reset();
+
+    {
+        AllocProfile::Scope a(outer);
+        AllocProfile::noteAllocation(16);
+        {
+            AllocProfile::Scope b(inner);
+            AllocProfile::noteAllocation(100);
+            AllocProfile::noteAllocation(28);
+        }
+        AllocProfile::noteAllocation(8);
+    }
+    {
+        AllocProfile::Scope b(inner);
+    }
+
+    AllocProfile::SiteStats o = AllocProfile::stats("test::outer");
+    CHECK(o.calls == 1);
+    CHECK(o.allocs == 2);
+    CHECK(o.bytes == 24);
+
+    AllocProfile::SiteStats i = AllocProfile::stats("test::inner");
+    CHECK(i.calls == 2);
+    CHECK(i.allocs == 2);
+    CHECK(i.bytes == 128);
+
+    const std::uint64_t before = AllocProfile::stats("(unattributed)").allocs;
+    AllocProfile::noteAllocation(1);
+    CHECK(AllocProfile::stats("(unattributed)").allocs == before + 1);
+
+    CHECK(AllocProfile::stats("test::never").calls == 0);
+}
+
+//
+// Test the table: snapshot lists registered sites, reset zeroes them.
+//
+TEST_CASE("AllocProfile: snapshot and reset") {
+    AllocProfile::registerSite("test::listed");
+    AllocProfile::SiteStats all[AllocProfile::kMaxSites];
+    int n = AllocProfile::snapshot(all);
+    bool found = false;
+    for (int k = 0; k < n; ++k) found = found || std::string(all[k].site) == "test::listed";
+    CHECK(found);
+
+    AllocProfile::Scope s(AllocProfile::registerSite("test::listed"));
+    AllocProfile::noteAllocation(4);
+    AllocProfile::reset();
+    CHECK(AllocProfile::stats("test::listed").calls == 0);
+    CHECK(AllocProfile::stats("test::listed").allocs == 0);
+}
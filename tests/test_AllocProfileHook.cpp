@@ -0,0 +1,60 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <new>
+#include <string>
+#include "../include/AllocProfile.hpp"
+#include "../include/Game.hpp"
+#include "../include/Player.hpp"
+
+// This test is built with COUP_ALLOC_PROFILE against the profile objects
+// (see the makefile), so the replaced operator new is the one counting.
+
+//
+// Test that real allocations are charged to the engine's call site.
+//
+TEST_CASE("AllocProfile hook: engine allocations go to their ALLOC_SITE") {
+    REQUIRE(AllocProfile::enabled());
+
+    Game game;
+    Player solo("Solo", RoleId::Spy, &game);
+    game.addPlayer(&solo);
+    AllocProfile::reset();
+
+    std::size_t names = 0;
+    for (int i = 0; i < 5; ++i) names += game.players().size();
+    CHECK(names == 5);
+
+    // One vector per call; "Solo" fits in the string's own buffer
+    AllocProfile::SiteStats s = AllocProfile::stats("Game::players");
+    CHECK(s.calls == 5);
+    CHECK(s.allocs == 5);
+    CHECK(s.bytes == 5 * sizeof(std::string));
+}
+
+//
+// Test the hook on a scope of our own, and outside every scope. operator
+// new is called directly, so the optimizer cannot fold the pairs away.
+//
+TEST_CASE("AllocProfile hook: local and unattributed allocations") {
+    AllocProfile::reset();
+    {
+        ALLOC_SITE("test::hook");
+        void* a = ::operator new(16);
+        void* b = ::operator new(40);
+        ::operator delete(b);
+        ::operator delete(a);
+    }
+    AllocProfile::SiteStats s = AllocProfile::stats("test::hook");
+    CHECK(s.calls == 1);
+    CHECK(s.allocs == 2);
+    CHECK(s.bytes == 56);
+
+    const AllocProfile::SiteStats before = AllocProfile::stats("(unattributed)");
+    void* raw = ::operator new(24);
+    const AllocProfile::SiteStats after = AllocProfile::stats("(unattributed)");
+    ::operator delete(raw);
+    CHECK(after.allocs == before.allocs + 1);
+    CHECK(after.bytes == before.bytes + 24);
+    CHECK(AllocProfile::stats("test::hook").allocs == 2);
+}
@@ -0,0 +1,177 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <vector>
+#include "../include/MatchArena.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Spy.hpp"
+#include "../include/Baron.hpp"
+#include "../include/Judge.hpp"
+
+namespace {
+
+class Briber : public Role {
+public:
+    std::unique_ptr<Role> clone() const override { return std::make_unique<Briber>(*this); }
+    bool canBribe() const override { return true; }
+    void specialAction(Player& /*self*/, Player& /*target*/) override { }
+    std::string name() const override { return "Briber"; }
+};
+
+void seat(MatchArena& arena) {
+    arena.addPlayer<Governor>("Gov");
+    arena.addPlayer<Spy>("Spy");
+    arena.addPlayer<Baron>("Baron");
+}
+
+} // namespace
+
+//
+// Test that a batch ends where the same Player calls one by one end.
+//
+TEST_CASE("applyBatch: same position as Player calls") {
+    MatchArena byPlayer;
+    seat(byPlayer);
+    Game& a = byPlayer.game();
+    Player& gov = *a.playerAt(0);
+    Player& spy = *a.playerAt(1);
+    Player& baron = *a.playerAt(2);
+    gov.gather();
+    spy.gather();
+    baron.gather();
+    gov.tax();
+    spy.gather();
+    baron.gather();
+    gov.gather();
+
+    MatchArena byBatch;
+    seat(byBatch);
+    Game& b = byBatch.game();
+    const std::vector<Action> moves = {
+        {ActionType::Gather, GameState::kNoSeat}, {ActionType::Gather, GameState::kNoSeat},
+        {ActionType::Gather, GameState::kNoSeat}, {ActionType::Tax, GameState::kNoSeat},
+        {ActionType::Gather, GameState::kNoSeat}, {ActionType::Gather, GameState::kNoSeat},
+        {ActionType::Gather, GameState::kNoSeat},
+    };
+    Game::BatchResult r = b.applyBatch(moves);
+    CHECK(r.index == moves.size());
+    CHECK(r.reason == ActionResult::Ok);
+
+    CHECK(b.state().hash == a.state().hash);
+    CHECK(b.turn() == a.turn());
+    for (int s = 0; s < 3; ++s) CHECK(b.playerAt(s)->coins() == a.playerAt(s)->coins());
+
+    CHECK(b.applyBatch(nullptr, 0).index == 0);
+    CHECK(b.state().hash == a.state().hash);
+}
+
+//
+// Test that the batch stops at the first rejected action and reports it,
+// keeping everything played before it.
+//
+TEST_CASE("applyBatch: stops at the first rejection") {
+    MatchArena arena;
+    seat(arena);
+    Game& g = arena.game();
+
+    const Action moves[] = {
+        {ActionType::Gather, GameState::kNoSeat},   // Gov
+        {ActionType::Tax, GameState::kNoSeat},      // Spy may not tax
+        {ActionType::Gather, GameState::kNoSeat},
+    };
+    Game::BatchResult r = g.applyBatch(moves, 3);
+    CHECK(r.index == 1);
+    CHECK(r.reason == ActionResult::NotAllowed);
+    CHECK(g.turn() == "Spy");
+    CHECK(g.playerAt(0)->coins() == 1);
+
+    g.playerAt(1)->addCoins(7);
+    const std::uint64_t before = g.state().hash;
+    const Action badTarget[] = {{ActionType::Coup, 42}};
+    r = g.applyBatch(badTarget, 1);
+    CHECK(r.index == 0);
+    CHECK(r.reason == ActionResult::InvalidPlayer);
+    CHECK(g.state().hash == before);
+
+    const Action broke[] = {{ActionType::Gather, GameState::kNoSeat}, {ActionType::Coup, 0}};
+    r = g.applyBatch(broke, 2);
+    CHECK(r.index == 1);
+    CHECK(r.reason == ActionResult::OutOfCoins);
+    CHECK(g.turn() == "Baron");
+}
+
+//
+// Test a block inside the batch: a Bribe stays pending until the briber's
+// turn ends, so a Judge later in the same batch can still cancel it.
+//
+TEST_CASE("applySteps: blocks between actions") {
+    using Step = Game::BatchStep;
+    const Action bribe{ActionType::Bribe, GameState::kNoSeat};
+    const Action gather{ActionType::Gather, GameState::kNoSeat};
+
+    MatchArena open;
+    Player& b1 = open.addPlayer<Briber>("Briber");
+    open.addPlayer<Judge>("Judge");
+    b1.addCoins(4);
+    const std::vector<Step> unblocked = {Step::act(bribe), Step::act(gather), Step::act(gather)};
+    CHECK(open.game().applySteps(unblocked).index == 3);
+    CHECK(b1.coins() == 2);                     // extra turn: two gathers
+    CHECK(open.game().turn() == "Judge");
+
+    MatchArena arena;
+    Player& b2 = arena.addPlayer<Briber>("Briber");
+    Player& judge = arena.addPlayer<Judge>("Judge");
+    Game& g = arena.game();
+    b2.addCoins(4);
+    const std::vector<Step> blocked = {
+        Step::act(bribe), Step::block(judge.id(), ActionType::Bribe, b2.id()), Step::act(gather),
+    };
+    Game::BatchResult r = g.applySteps(blocked);
+    CHECK(r.index == 3);
+    CHECK(r.reason == ActionResult::Ok);
+    CHECK(b2.coins() == 1);                     // one gather, the bribe is lost
+    CHECK(g.turn() == "Judge");
+    CHECK(g.state().pendingCount == 0);
+
+    // The Bribe was resolved when the briber's turn ended, so there is
+    // nothing left to block; unknown seats are rejected before anything runs.
+    const std::vector<Step> late = {Step::act(gather), Step::block(judge.id(), ActionType::Bribe, b2.id())};
+    r = g.applySteps(late);
+    CHECK(r.index == 1);
+    CHECK(r.reason == ActionResult::NoPending);
+    const std::uint64_t before = g.state().hash;
+    const Step ghost = Step::block(judge.id(), ActionType::Bribe, 42);
+    r = g.applySteps(&ghost, 1);
+    CHECK(r.index == 0);
+    CHECK(r.reason == ActionResult::InvalidPlayer);
+    CHECK(g.state().hash == before);
+}
+
+//
+// Test that Block steps are held to the blocker's role: a Spy cannot block
+// Tax, and a Governor cannot block its own.
+//
+TEST_CASE("applySteps: blocks need a role that may make them") {
+    using Step = Game::BatchStep;
+    MatchArena arena;
+    seat(arena);
+    Game& g = arena.game();
+    Player& gov = *g.playerAt(0);
+    Player& spy = *g.playerAt(1);
+    g.registerTax(&gov);
+    const std::uint64_t before = g.state().hash;
+
+    const Step bySpy = Step::block(spy.id(), ActionType::Tax, gov.id());
+    Game::BatchResult r = g.applySteps(&bySpy, 1);
+    CHECK(r.index == 0);
+    CHECK(r.reason == ActionResult::NotAllowed);
+
+    const Step own = Step::block(gov.id(), ActionType::Tax, gov.id());
+    r = g.applySteps(&own, 1);
+    CHECK(r.index == 0);
+    CHECK(r.reason == ActionResult::NotAllowed);
+    CHECK(g.state().hash == before);            // the Tax is still pending
+
+    g.nextTurn();
+    CHECK(gov.coins() == 3);
+}
@@ -1,10 +1,15 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
+#include <cstring>
 #include "../include/Game.hpp"
 #include "../include/Player.hpp"
 #include "../include/Governor.hpp"
 #include "../include/Spy.hpp"
+#include "../include/Baron.hpp"
+#include "../include/General.hpp"
+#include "../include/Judge.hpp"
+#include "../include/Merchant.hpp"
 #include "../include/Exceptions.hpp"
 
 //
@@ -260,3 +265,147 @@ TEST_CASE("Game: winner logic for multiple and single") {
     game.removePlayer(&a);
     CHECK(game.winner() == "C");
 }
+
+//
+// Test legalActions through the Game facade: no exceptions, seat targets.
+//
+TEST_CASE("Game: legalActions for current and waiting players") {
+    Game game;
+    Player a("A", std::make_unique<Governor>(), &game);
+    Player b("B", std::make_unique<Spy>(), &game);
+    game.addPlayer(&a);
+    game.addPlayer(&b);
+
+    ActionBuffer moves;
+    game.legalActions(b, moves);
+    CHECK(moves.empty());
+
+    a.addCoins(7);
+    game.legalActions(a, moves);
+    REQUIRE(moves.size() == 3);   // Gather, Tax, Coup on B
+    CHECK(moves[2].type == ActionType::Coup);
+    CHECK(game.playerAt(moves[2].target) == &b);
+}
+
+//
+// Test dense integer ids and the hashed name index.
+//
+TEST_CASE("Game: player ids and idOf") {
+    Game game;
+    Player a("A", std::make_unique<Governor>(), &game);
+    Player b("B", std::make_unique<Spy>(), &game);
+    CHECK(a.id() == GameState::kNoSeat);
+    game.addPlayer(&a);
+    game.addPlayer(&b);
+    CHECK(a.id() == 0);
+    CHECK(b.id() == 1);
+    CHECK(game.idOf("B") == b.id());
+    CHECK(game.idOf("nobody") == GameState::kNoSeat);
+
+    // A removed name is free again and gets a fresh id
+    game.removePlayer(&b);
+    CHECK(game.idOf("B") == GameState::kNoSeat);
+    Player b2("B", std::make_unique<Spy>(), &game);
+    game.addPlayer(&b2);
+    CHECK(b2.id() == 2);
+    CHECK(game.idOf("B") == 2);
+}
+
+//
+// Test make/unmake: apply() then undo() restores the exact state, including
+// a Coup removal, Bribe's extra-turn rewind and the pending store.
+//
+TEST_CASE("Game: apply and undo") {
+    Game game;
+    Player a("A", std::make_unique<Governor>(), &game);
+    Player b("B", std::make_unique<Spy>(), &game);
+    Player c("C", std::make_unique<Merchant>(), &game);
+    game.addPlayer(&a);
+    game.addPlayer(&b);
+    game.addPlayer(&c);
+    a.addCoins(7);
+    GameState start;
+    std::memcpy(&start, &game.state(), sizeof(GameState));
+
+    CHECK(game.apply({ActionType::Tax, GameState::kNoSeat}) == ActionResult::Ok);
+    CHECK(a.coins() == 10);
+    CHECK(game.apply({ActionType::Coup, a.id()}) == ActionResult::OutOfCoins);
+    CHECK(game.undoDepth() == 1);
+    CHECK(game.undo());
+    CHECK(std::memcmp(&game.state(), &start, sizeof(GameState)) == 0);
+    CHECK(game.turn() == "A");
+
+    // Coup removes C; undo brings C back with the turn order intact
+    std::uint64_t startHash = game.hash();
+    CHECK(game.apply({ActionType::Coup, c.id()}) == ActionResult::Ok);
+    CHECK(game.players().size() == 2);
+    CHECK(game.apply({ActionType::Gather, GameState::kNoSeat}) == ActionResult::Ok);
+    CHECK(game.undo());
+    CHECK(game.undo());
+    CHECK_FALSE(game.undo());
+    CHECK(std::memcmp(&game.state(), &start, sizeof(GameState)) == 0);
+    CHECK(game.players().size() == 3);
+    CHECK(a.coins() == 7);
+    CHECK(game.hash() == startHash);
+
+    // A pending Bribe resolves during apply(); undo restores it and the index
+    game.registerBribe(&a);
+    GameState bribed;
+    std::memcpy(&bribed, &game.state(), sizeof(GameState));
+    CHECK(game.apply({ActionType::Gather, GameState::kNoSeat}) == ActionResult::Ok);
+    CHECK(game.turn() == "A");
+    CHECK(game.state().pendingCount == 0);
+    CHECK(game.undo());
+    CHECK(std::memcmp(&game.state(), &bribed, sizeof(GameState)) == 0);
+    CHECK(game.state().findPending(ActionType::Bribe, a.id()) == 0);
+}
+
+//
+// Test that a role outside the built-ins still has its start-of-turn,
+// arrest and sanction hooks run when the engine resolves them.
+//
+TEST_CASE("Game: custom role hooks run on resolution") {
+    struct Calls { int startTurn = 0, arrested = 0, sanctioned = 0; };
+    class Hooked : public Role {
+    public:
+        explicit Hooked(Calls* calls) : _calls(calls) {}
+        std::unique_ptr<Role> clone() const override { return std::make_unique<Hooked>(*this); }
+        void specialAction(Player& /*self*/, Player& /*target*/) override { }
+        std::string name() const override { return "Hooked"; }
+        void onStartTurn(Player& self) override { ++_calls->startTurn; self.addCoins(1); }
+        void onArrested(Player& /*self*/) override { ++_calls->arrested; }
+        void onSanctioned(Player& /*self*/) override { ++_calls->sanctioned; }
+
+    private:
+        Calls* _calls;
+    };
+
+    Calls calls;
+    Game game;
+    Player gov("Gov", std::make_unique<Governor>(), &game);
+    Player hook("Hook", std::make_unique<Hooked>(&calls), &game);
+    game.addPlayer(&gov);
+    game.addPlayer(&hook);
+    CHECK(game.state().roles[hook.id()] == RoleId::Custom);
+
+    gov.gather();
+    CHECK(game.turn() == "Hook");
+    CHECK(calls.startTurn == 1);
+    CHECK(hook.coins() == 1);
+
+    hook.addCoins(4);
+    hook.gather();
+    game.registerArrest(&gov, &hook);
+    game.registerSanction(&gov, &hook);
+    game.nextTurn();
+    CHECK(calls.arrested == 1);
+    CHECK(calls.sanctioned == 1);
+    CHECK(calls.startTurn == 2);
+
+    // Copies of the state carry no hooks: the Custom row of kRoleRules applies.
+    GameState copy = game.state();
+    CHECK(copy.hooks == nullptr);
+    copy.nextTurn();
+    copy.nextTurn();
+    CHECK(calls.startTurn == 2);
+}
@@ -0,0 +1,229 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <cstring>
+#include "../include/ActionBuffer.hpp"
+#include "../include/GameState.hpp"
+
+namespace {
+constexpr std::uint8_t kAll = GameState::CanGather | GameState::CanTax | GameState::CanBribe
+                            | GameState::CanArrest | GameState::CanSanction | GameState::CanCoup;
+}
+
+//
+// Test seats, turn order and the trivially-copyable contract.
+//
+TEST_CASE("GameState: seats, turn order and copy") {
+    GameState s;
+    CHECK(s.pool == GameState::kStartingPool);
+    CHECK(s.currentSeat() == GameState::kNoSeat);
+
+    int a = s.addSeat(RoleId::Governor, kAll, 0);
+    int b = s.addSeat(RoleId::Spy, GameState::CanGather, 0);
+    CHECK(a == 0);
+    CHECK(b == 1);
+    CHECK(s.currentSeat() == a);
+
+    CHECK(s.gather(b) == ActionResult::NotYourTurn);
+    CHECK(s.gather(a) == ActionResult::Ok);
+    CHECK(s.coins[a] == 1);
+    CHECK(s.currentSeat() == b);
+
+    // A copy is independent of the original
+    GameState copy;
+    std::memcpy(&copy, &s, sizeof(GameState));
+    CHECK(copy.gather(b) == ActionResult::Ok);
+    CHECK(copy.coins[b] == 1);
+    CHECK(s.coins[b] == 0);
+    CHECK(s.currentSeat() == b);
+}
+
+//
+// Test Tax (Governor gets 3), blocking and the pool.
+//
+TEST_CASE("GameState: tax, block and pool") {
+    GameState s;
+    int gov = s.addSeat(RoleId::Governor, kAll, 0);
+    int spy = s.addSeat(RoleId::Spy, GameState::CanGather, 0);
+
+    CHECK(s.tax(gov) == ActionResult::Ok);
+    CHECK(s.coins[gov] == 3);
+    CHECK(s.tax(spy) == ActionResult::NotAllowed);
+
+    // Register directly so the Tax is still pending when blocked
+    s.registerAction(ActionType::Tax, gov, GameState::kNoSeat);
+    CHECK(s.blockTax(gov) == ActionResult::Ok);
+    CHECK(s.blockTax(gov) == ActionResult::NoPending);
+    s.nextTurn();
+    CHECK(s.coins[gov] == 3);
+
+    CHECK(s.takeFromPool(10) == ActionResult::Ok);
+    CHECK(s.pool == 40);
+    CHECK(s.takeFromPool(1000) == ActionResult::PoolEmpty);
+}
+
+//
+// Test Bribe extra turn, Arrest hooks and Coup removal.
+//
+TEST_CASE("GameState: bribe, arrest and coup") {
+    GameState s;
+    int a = s.addSeat(RoleId::Baron, kAll, 4);
+    int mer = s.addSeat(RoleId::Merchant, GameState::CanGather, 3);
+    int gen = s.addSeat(RoleId::General, GameState::CanGather, 0);
+
+    // Bribe: pay 4, stay on the same player after resolution
+    CHECK(s.bribe(a) == ActionResult::Ok);
+    CHECK(s.coins[a] == 0);
+    s.nextTurn();
+    CHECK(s.currentSeat() == a);
+
+    // Arrest a Merchant: 2 stolen, then Merchant's onArrested removes 1 more
+    CHECK(s.arrest(a, a) == ActionResult::SelfTarget);
+    CHECK(s.arrest(a, mer) == ActionResult::Ok);
+    CHECK(s.coins[a] == 2);
+    CHECK(s.coins[mer] == 0);
+
+    // Coup removes the target and keeps the turn order consistent
+    s.coins[mer] = 7;
+    CHECK(s.currentSeat() == mer);
+    CHECK(s.coup(mer, gen) == ActionResult::Ok);
+    CHECK_FALSE(s.isAlive(gen));
+    CHECK(s.activeCount == 2);
+    CHECK(s.currentSeat() == a);
+    CHECK(s.winner() == GameState::kNoSeat);
+
+    CHECK(s.removePlayer(mer) == ActionResult::Ok);
+    CHECK(s.winner() == a);
+}
+
+//
+// Test the legal-move generator: turn, abilities, thresholds and must-coup.
+//
+TEST_CASE("GameState: legalActions") {
+    GameState s;
+    int gov = s.addSeat(RoleId::Governor, GameState::abilitiesOf(RoleId::Governor), 0);
+    int spy = s.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 0);
+    int mer = s.addSeat(RoleId::Merchant, GameState::abilitiesOf(RoleId::Merchant), 0);
+
+    ActionBuffer moves;
+    s.legalActions(spy, moves);
+    CHECK(moves.empty());               // not Spy's turn
+
+    s.legalActions(gov, moves);
+    REQUIRE(moves.size() == 2);         // Gather, Tax
+    CHECK(moves[0].type == ActionType::Gather);
+    CHECK(moves[1].type == ActionType::Tax);
+
+    s.coins[gov] = 7;                   // Coup on each opponent becomes legal
+    s.legalActions(gov, moves);
+    CHECK(moves.size() == 4);
+    for (const Action& a : moves) {
+        GameState probe = s;            // every generated move is accepted
+        CHECK(probe.apply(gov, a) == ActionResult::Ok);
+    }
+
+    s.coins[spy] = 10;                  // must coup: only Coup targets remain
+    s.currentIndex = 1;
+    s.legalActions(spy, moves);
+    REQUIRE(moves.size() == 2);
+    CHECK(moves[0].type == ActionType::Coup);
+    CHECK(moves[0].target == gov);
+    CHECK(moves[1].target == mer);
+}
+
+//
+// Test the role rule table: abilities and the role hooks it drives.
+//
+TEST_CASE("GameState: role rules table") {
+    static_assert(GameState::abilitiesOf(RoleId::Governor) == (GameState::CanGather | GameState::CanTax),
+                  "only the Governor can tax");
+    static_assert(rulesOf(RoleId::Merchant).arrestLoss == 2, "Merchant loses 2 on arrest");
+
+    GameState s;
+    int gen = s.addSeat(RoleId::General, GameState::abilitiesOf(RoleId::General), 0);
+    int mer = s.addSeat(RoleId::Merchant, GameState::abilitiesOf(RoleId::Merchant), 3);
+    int bar = s.addSeat(RoleId::Baron, GameState::abilitiesOf(RoleId::Baron), 0);
+
+    s.nextTurn();                         // Merchant starts with 3 → +1
+    CHECK(s.coins[mer] == 4);
+
+    s.registerAction(ActionType::Arrest, mer, gen);
+    s.registerAction(ActionType::Sanction, mer, bar);
+    s.nextTurn();
+    CHECK(s.coins[gen] == 1);             // nothing to steal, General refund +1
+    CHECK(s.coins[bar] == 1);             // Baron compensation +1
+}
+
+//
+// Test the indexed pending store: FIFO per key, tombstones, O(1) lookup.
+//
+TEST_CASE("GameState: indexed pending store") {
+    GameState s;
+    int a = s.addSeat(RoleId::Governor, GameState::abilitiesOf(RoleId::Governor), 0);
+    int b = s.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 0);
+
+    s.registerAction(ActionType::Tax, a, GameState::kNoSeat);
+    s.registerAction(ActionType::Arrest, a, b);
+    s.registerAction(ActionType::Tax, a, GameState::kNoSeat);
+    CHECK(s.findPending(ActionType::Tax, a) == 0);
+    CHECK(s.findPending(ActionType::Arrest, b) == 1);
+    CHECK(s.findPending(ActionType::Arrest, a) == -1);
+
+    // Blocking tombstones the oldest match; the next one moves up
+    CHECK(s.blockTax(a) == ActionResult::Ok);
+    CHECK(s.pending[0].blocked);
+    CHECK(s.findPending(ActionType::Tax, a) == 2);
+    CHECK(s.blockArrest(b) == ActionResult::Ok);
+    CHECK(s.blockArrest(b) == ActionResult::NoPending);
+
+    // Only the live Tax resolves; the index is empty afterwards
+    s.nextTurn();
+    CHECK(s.coins[a] == 3);
+    CHECK(s.pendingCount == 0);
+    CHECK(s.findPending(ActionType::Tax, a) == -1);
+    CHECK(s.registerAction(ActionType::Arrest, a, 99) == ActionResult::InvalidPlayer);
+}
+
+//
+// Test the incremental Zobrist hash against a full recomputation.
+//
+TEST_CASE("GameState: incremental hash") {
+    GameState s;
+    CHECK(s.hash == s.computeHash());
+    int gov = s.addSeat(RoleId::Governor, GameState::abilitiesOf(RoleId::Governor), 0);
+    int spy = s.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 0);
+    int bar = s.addSeat(RoleId::Baron, kAll, 8);
+    CHECK(s.hash == s.computeHash());
+
+    // Same position reached in two orders hashes the same
+    GameState t = s;
+    s.addCoins(gov, 2);
+    s.removeCoins(bar, 1);
+    t.removeCoins(bar, 1);
+    t.addCoins(gov, 2);
+    CHECK(s.hash == t.hash);
+    CHECK(s.hash == s.computeHash());
+
+    // Pending slots, blocking, resolution, pool and removal are covered
+    std::uint64_t before = s.hash;
+    s.registerAction(ActionType::Tax, gov, GameState::kNoSeat);
+    CHECK(s.hash != before);
+    s.registerAction(ActionType::Sanction, bar, spy);
+    CHECK(s.blockTax(gov) == ActionResult::Ok);
+    CHECK(s.hash == s.computeHash());
+    s.nextTurn();
+    CHECK(s.hash == s.computeHash());
+    s.takeFromPool(5);
+    s.returnToPool(2);
+    CHECK(s.coup(spy, bar) == ActionResult::OutOfCoins);
+    s.setCoins(spy, 7);
+    CHECK(s.coup(spy, bar) == ActionResult::Ok);
+    CHECK_FALSE(s.isAlive(bar));
+    CHECK(s.hash == s.computeHash());
+
+    // Direct field writes need a rehash
+    s.coins[gov] = 40;
+    CHECK(s.hash != s.computeHash());
+    s.rehash();
+    CHECK(s.hash == s.computeHash());
+}
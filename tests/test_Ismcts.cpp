@@ -0,0 +1,60 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <random>
+#include "../ai/Ismcts.hpp"
+
+//
+// Test that determinizations keep the observer's data and respect beliefs.
+//
+TEST_CASE("Ismcts: determinize") {
+    GameState g;
+    int me = g.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 2);
+    int gov = g.addSeat(RoleId::Governor, GameState::abilitiesOf(RoleId::Governor), 6);
+    int other = g.addSeat(RoleId::Baron, GameState::abilitiesOf(RoleId::Baron), 4);
+
+    ObservationLog log;
+    log.recordJoin(me, 2);
+    log.recordJoin(gov, 0);
+    log.recordJoin(other, 4);
+    log.recordAction(gov, {ActionType::Tax, GameState::kNoSeat});
+    log.recordAction(gov, {ActionType::Tax, GameState::kNoSeat});
+    ObservationLog::Belief beliefs[GameState::kMaxPlayers];
+    log.beliefs(me, beliefs);
+
+    std::mt19937_64 rng(7);
+    const SearchState truth(g);
+    bool sawOtherRole = false;
+    for (int i = 0; i < 50; ++i) {
+        SearchState d = Ismcts::determinize(truth, me, beliefs, rng);
+        CHECK(d.game.roles[me] == RoleId::Spy);
+        CHECK(d.game.coins[me] == 2);
+        CHECK(d.game.roles[gov] == RoleId::Governor);
+        CHECK(d.game.coins[gov] == 6);
+        CHECK(d.game.coins[other] == 4);
+        CHECK(d.game.hash == d.game.computeHash());
+        sawOtherRole |= d.game.roles[other] != RoleId::Baron;
+    }
+    CHECK(sawOtherRole);                          // the Baron's role stays hidden
+}
+
+//
+// Test that the search still finds a Coup that wins in every determinization.
+//
+TEST_CASE("Ismcts: search") {
+    GameState g;
+    int me = g.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 7);
+    int other = g.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 0);
+
+    ObservationLog log;
+    log.recordJoin(me, 7);
+    log.recordJoin(other, 0);
+
+    MctsConfig config;
+    config.iterations = 1000;
+    Ismcts search(config);
+    Decision d = search.search(SearchState(g), me, log);
+    CHECK(search.iterations() == 1000);
+    CHECK(d.action.type == ActionType::Coup);
+    CHECK(d.action.target == other);
+}
@@ -0,0 +1,85 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../include/MatchArena.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Spy.hpp"
+#include "../include/Merchant.hpp"
+
+namespace {
+
+// Counts its destructions so the test can see reset() clean up.
+int gRolesAlive = 0;
+
+class CountedRole : public Role {
+public:
+    CountedRole() { ++gRolesAlive; }
+    ~CountedRole() override { --gRolesAlive; }
+    std::unique_ptr<Role> clone() const override { return std::make_unique<CountedRole>(); }
+    void specialAction(Player&, Player&) override {}
+    std::string name() const override { return "Counted"; }
+};
+
+bool inside(const MatchArena& a, const void* block, const void* p) {
+    const unsigned char* b = static_cast<const unsigned char*>(block);
+    const unsigned char* q = static_cast<const unsigned char*>(p);
+    return q >= b && q < b + a.capacity();
+}
+
+} // namespace
+
+//
+// Test a match in the arena: players are seated, play normally and live in
+// the arena's block behind the Game.
+//
+TEST_CASE("MatchArena: players and game share one block") {
+    MatchArena arena;
+    const std::size_t empty = arena.used();
+    Player& a = arena.addPlayer<Governor>("A");
+    Player& b = arena.addPlayer<Spy>("B");
+    Player& c = arena.addPlayer<Merchant>("C");
+    CHECK(arena.used() > empty);
+
+    Game& g = arena.game();
+    const void* block = &g;
+    CHECK(inside(arena, block, &a));
+    CHECK(inside(arena, block, &c));
+    CHECK(&b > &a);
+    CHECK(&c > &b);
+
+    CHECK(g.players().size() == 3);
+    CHECK(g.turn() == "A");
+    a.tax();
+    b.gather();
+    CHECK(g.turn() == "C");
+    CHECK(a.coins() == 3);
+    CHECK(a.roleName() == "Governor");
+}
+
+//
+// Test reset: destructors run, the block is rewound and reused, and the
+// next match starts from an empty Game.
+//
+TEST_CASE("MatchArena: reset and overflow") {
+    MatchArena arena;
+    const std::size_t empty = arena.used();
+    const void* first = &arena.game();
+    arena.addPlayer<CountedRole>("A");
+    arena.addPlayer<CountedRole>("B");
+    CHECK(gRolesAlive == 2);
+
+    arena.reset();
+    CHECK(gRolesAlive == 0);
+    CHECK(arena.used() == empty);
+    CHECK(&arena.game() == first);
+    CHECK(arena.game().players().empty());
+
+    Player& again = arena.addPlayer<CountedRole>("A");
+    CHECK(again.name() == "A");
+    CHECK_THROWS_AS(arena.addPlayer<CountedRole>("A"), IllegalAction);
+    arena.reset();
+    CHECK(gRolesAlive == 0);
+
+    MatchArena tiny(sizeof(Game) + 64);
+    CHECK_THROWS_AS(tiny.addPlayer<Governor>("A"), std::bad_alloc);
+}
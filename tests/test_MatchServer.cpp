@@ -0,0 +1,307 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../server/MatchServer.hpp"
+#include "../server/LatencyHistogram.hpp"
+
+namespace {
+
+const char* kSocket = "test_match_server.sock";
+
+// A blocking client that sends one command and reads back one reply line.
+class Client {
+public:
+    explicit Client(const char* path) : _fd(::socket(AF_UNIX, SOCK_STREAM, 0)) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+        _ok = _fd >= 0 && ::connect(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    }
+    ~Client() { if (_fd >= 0) ::close(_fd); }
+
+    bool connected() const { return _ok; }
+
+    std::string ask(const std::string& command) {
+        std::string line = command + "\n";
+        if (::write(_fd, line.data(), line.size()) != static_cast<ssize_t>(line.size())) return "write failed";
+        return readLine();
+    }
+
+    /// The next reply line (for commands sent several at a time).
+    std::string readLine() {
+        std::string reply;
+        char ch;
+        while (::read(_fd, &ch, 1) == 1 && ch != '\n') reply += ch;
+        return reply;
+    }
+
+private:
+    int  _fd;
+    bool _ok;
+};
+
+std::string idOf(const std::string& reply) {
+    return reply.compare(0, 3, "OK ") == 0 ? reply.substr(3) : "?";
+}
+
+// STATE of a match once its reaction window has passed the turn to seat
+// (or after about a second).
+std::string stateOnTurn(Client& c, const std::string& id, int seat) {
+    const std::string turn = "OK turn=" + std::to_string(seat) + " ";
+    std::string state = c.ask("STATE " + id);
+    for (int i = 0; i < 200 && state.compare(0, turn.size(), turn) != 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        state = c.ask("STATE " + id);
+    }
+    return state;
+}
+
+} // namespace
+
+//
+// Test a scripted client playing one match through the protocol.
+//
+TEST_CASE("MatchServer: scripted match") {
+    MatchServer server(kSocket, 2, 200);
+    server.start();
+    Client c(kSocket);
+    REQUIRE(c.connected());
+
+    const std::string id = idOf(c.ask("NEW Governor Spy"));
+    REQUIRE(id != "?");
+    CHECK(c.ask("ACT " + id + " 0 Tax") == "OK window=200");
+    CHECK(c.ask("ACT " + id + " 0 Gather") == "ERR window open");
+    CHECK(stateOnTurn(c, id, 1) == "OK turn=1 pool=50 coins=3,0 alive=3");
+    CHECK(c.ask("ACT " + id + " 0 Gather") == "ERR NotYourTurn");
+    CHECK(c.ask("ACT " + id + " 1 Tax") == "ERR NotAllowed");
+    CHECK(c.ask("ACT " + id + " 1 Coup 5") == "ERR InvalidPlayer");
+    CHECK(c.ask("ACT " + id + " 1 Gather") == "OK turn=0");
+    CHECK(c.ask("STATE " + id) == "OK turn=0 pool=50 coins=3,1 alive=3");
+
+    CHECK(c.ask("NEW Governor") .compare(0, 3, "ERR") == 0);
+    CHECK(c.ask("NEW Governor Wizard") == "ERR unknown role");
+    CHECK(c.ask("FLY") == "ERR unknown command");
+    CHECK(c.ask("STATE 999999") .compare(0, 3, "ERR") == 0);
+
+    const std::string stats = c.ask("STATS");
+    CHECK(stats.compare(0, 11, "OK shard=0 ") == 0);
+    CHECK(stats.find("; shard=1 ") != std::string::npos);
+    CHECK(stats.find("turns=6") != std::string::npos);
+
+    CHECK(c.ask("END " + id) == "OK");
+    CHECK(c.ask("STATE " + id) == "ERR no such match");
+    server.stop();
+}
+
+//
+// Test concurrent clients, each with many matches: every reply is right,
+// matches spread over the shards and every turn is timed.
+//
+TEST_CASE("MatchServer: many clients and matches") {
+    constexpr int kClients = 8;
+    constexpr int kMatchesPerClient = 250;
+    MatchServer server(kSocket, 4);
+    server.start();
+
+    std::atomic<int> bad{0};
+    std::vector<std::thread> clients;
+    for (int t = 0; t < kClients; ++t) {
+        clients.emplace_back([&] {
+            Client c(kSocket);
+            if (!c.connected()) {
+                ++bad;
+                return;
+            }
+            std::vector<std::string> ids;
+            for (int m = 0; m < kMatchesPerClient; ++m) {
+                ids.push_back(idOf(c.ask("NEW Governor Spy Baron General Judge Merchant")));
+            }
+            for (const std::string& id : ids) {
+                for (int seat = 0; seat < 6; ++seat) {
+                    if (c.ask("ACT " + id + " " + std::to_string(seat) + " Gather")
+                        != "OK turn=" + std::to_string((seat + 1) % 6)) {
+                        ++bad;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& t : clients) t.join();
+    CHECK(bad == 0);
+
+    std::uint64_t matches = 0;
+    std::uint64_t turns = 0;
+    for (const MatchServer::ShardStats& s : server.stats()) {
+        matches += s.matches;
+        turns += s.turns;
+        CHECK(s.p50 <= s.p99);
+        CHECK(s.p99 <= s.max);
+    }
+    CHECK(matches == kClients * kMatchesPerClient);
+    CHECK(turns == kClients * kMatchesPerClient * 6);
+    server.stop();
+    CHECK(::access(kSocket, F_OK) != 0);
+}
+
+//
+// Test reaction windows: ACT opens one for a pending action, BLOCK lands
+// inside it and its expiry resolves the action without any further command.
+//
+TEST_CASE("MatchServer: reaction windows") {
+    MatchServer server(kSocket, 1, 50);
+    server.start();
+    Client c(kSocket);
+    REQUIRE(c.connected());
+    const std::string id = idOf(c.ask("NEW Governor Governor Governor General"));
+
+    CHECK(c.ask("ACT " + id + " 0 Coup 9") == "ERR InvalidPlayer");
+    CHECK(c.ask("ACT " + id + " 0 Tax") == "OK window=50");
+    CHECK(c.ask("BLOCK " + id + " 3 Coup 1") == "ERR NoPending");
+    CHECK(c.ask("STATE " + id) == "OK turn=0 pool=50 coins=0,0,0,0 alive=15");
+    CHECK(server.stats()[0].windows == 1);
+
+    // Expiry passes the turn and pays the Tax.
+    std::string state = stateOnTurn(c, id, 1);
+    CHECK(state == "OK turn=1 pool=50 coins=3,0,0,0 alive=15");
+    CHECK(server.stats()[0].windows == 0);
+
+    // A block inside the window cancels the Tax.
+    CHECK(c.ask("ACT " + id + " 1 Tax") == "OK window=50");
+    CHECK(c.ask("BLOCK " + id + " 0 Tax 1") == "OK");
+    state = stateOnTurn(c, id, 2);
+    CHECK(state == "OK turn=2 pool=50 coins=3,0,0,0 alive=15");
+
+    // Nothing else is declared while a window is open, so it cannot be
+    // held open: it still closes on time.
+    CHECK(c.ask("ACT " + id + " 2 Tax") == "OK window=50");
+    CHECK(c.ask("ACT " + id + " 2 Tax") == "ERR window open");
+    state = stateOnTurn(c, id, 3);
+    CHECK(state == "OK turn=3 pool=50 coins=3,0,3,0 alive=15");
+
+    // Gather cannot be blocked and passes the turn at once; END closes an
+    // open window.
+    CHECK(c.ask("ACT " + id + " 3 Gather") == "OK turn=0");
+    CHECK(c.ask("ACT " + id + " 0 Tax") == "OK window=50");
+    CHECK(c.ask("END " + id) == "OK");
+    CHECK(server.stats()[0].windows == 0);
+    server.stop();
+}
+
+//
+// Test that any connection can drive any match: commands for a match on
+// another shard are mailed to it and answered in order, and a pipelined
+// burst over several shards comes back in the order it was sent.
+//
+TEST_CASE("MatchServer: commands reach matches on other shards") {
+    constexpr int kShards = 4;
+    MatchServer server(kSocket, kShards);
+    server.start();
+
+    // Connections land on whichever shard accepts them; open enough to
+    // have matches on more than one.
+    std::vector<std::unique_ptr<Client>> clients;
+    std::vector<std::string> ids;
+    bool shards[kShards] = {};
+    int seen = 0;
+    for (int i = 0; i < 64 && seen < 2; ++i) {
+        clients.push_back(std::make_unique<Client>(kSocket));
+        REQUIRE(clients.back()->connected());
+        ids.push_back(idOf(clients.back()->ask("NEW Governor Spy")));
+        REQUIRE(ids.back() != "?");
+        int shard = std::stoi(ids.back()) % kShards;
+        seen += !shards[shard];
+        shards[shard] = true;
+    }
+    REQUIRE(seen >= 2);
+
+    // Six turns in every match, each from a different client, whatever
+    // shard it is on.
+    for (std::size_t m = 0; m < ids.size(); ++m) {
+        for (std::size_t t = 0; t < 6; ++t) {
+            Client& c = *clients[(m + t) % clients.size()];
+            const bool first = t % 2 == 0;
+            CHECK(c.ask("ACT " + ids[m] + (first ? " 0" : " 1") + " Gather") == (first ? "OK turn=1" : "OK turn=0"));
+        }
+        CHECK(clients[(m + 1) % clients.size()]->ask("STATE " + ids[m]) == "OK turn=0 pool=50 coins=3,3 alive=3");
+    }
+
+    // Pipelined commands over several shards: replies in command order.
+    Client& c = *clients[0];
+    std::string burst;
+    for (const std::string& id : ids) burst += "STATE " + id + "\nEND " + id + "\nSTATE " + id + "\n";
+    CHECK(c.ask(burst + "STATS").compare(0, 9, "OK turn=0") == 0);
+    for (std::size_t m = 0; m < ids.size(); ++m) {
+        if (m > 0) CHECK(c.readLine().compare(0, 9, "OK turn=0") == 0);
+        CHECK(c.readLine() == "OK");
+        CHECK(c.readLine() == "ERR no such match");
+    }
+    CHECK(c.readLine().compare(0, 11, "OK shard=0 ") == 0);
+    for (const MatchServer::ShardStats& st : server.stats()) CHECK(st.matches == 0);
+    server.stop();
+}
+
+//
+// Test ACT and BLOCK from connections on other shards: the window opens
+// and expires on the match's shard, and a block mailed in from elsewhere
+// still lands inside it.
+//
+TEST_CASE("MatchServer: reaction windows across shards") {
+    constexpr int kShards = 4;
+    MatchServer server(kSocket, kShards, 50);
+    server.start();
+
+    std::vector<std::unique_ptr<Client>> clients;
+    std::vector<int> shardOf;
+    std::string id;
+    for (int i = 0; i < 64; ++i) {
+        clients.push_back(std::make_unique<Client>(kSocket));
+        REQUIRE(clients.back()->connected());
+        const std::string created = idOf(clients.back()->ask("NEW Governor Governor General"));
+        REQUIRE(created != "?");
+        shardOf.push_back(std::stoi(created) % kShards);
+        if (i == 0) id = created;
+        else if (shardOf.back() != shardOf[0]) break;
+    }
+    REQUIRE(shardOf.back() != shardOf[0]);
+    Client& owner = *clients[0];
+    Client& other = *clients.back();
+    const std::size_t home = static_cast<std::size_t>(shardOf[0]);
+
+    CHECK(other.ask("ACT " + id + " 0 Tax") == "OK window=50");
+    CHECK(server.stats()[home].windows == 1);
+    CHECK(server.stats()[static_cast<std::size_t>(shardOf.back())].windows == 0);
+    CHECK(owner.ask("BLOCK " + id + " 1 Tax 0") == "OK");
+    CHECK(other.ask("BLOCK " + id + " 1 Tax 0") == "ERR NoPending");
+
+    CHECK(stateOnTurn(other, id, 1) == "OK turn=1 pool=50 coins=0,0,0 alive=7");
+    CHECK(server.stats()[home].windows == 0);
+    server.stop();
+}
+
+//
+// Test the histogram's percentiles against a known distribution.
+//
+TEST_CASE("LatencyHistogram: percentiles within a bucket") {
+    LatencyHistogram h;
+    CHECK(h.percentile(0.5) == 0);
+    for (std::uint64_t v = 1; v <= 10000; ++v) h.record(v);
+    CHECK(h.count() == 10000);
+    CHECK(h.max() == 10000);
+    const std::uint64_t p50 = h.percentile(0.5);
+    const std::uint64_t p99 = h.percentile(0.99);
+    CHECK(p50 >= 5000);
+    CHECK(p50 <= 5000 * 1.125 + 1);
+    CHECK(p99 >= 9900);
+    CHECK(p99 <= 10000);
+    CHECK(h.percentile(1.0) == 10000);
+}
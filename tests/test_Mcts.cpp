@@ -0,0 +1,77 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../ai/Mcts.hpp"
+#include "../ai/SearchState.hpp"
+
+//
+// Test block windows: who is asked, and what Block and Pass do.
+//
+TEST_CASE("SearchState: block windows") {
+    GameState g;
+    int a = g.addSeat(RoleId::Governor, GameState::abilitiesOf(RoleId::Governor), 0);
+    int b = g.addSeat(RoleId::Governor, GameState::abilitiesOf(RoleId::Governor), 0);
+    int gen = g.addSeat(RoleId::General, GameState::abilitiesOf(RoleId::General), 5);
+
+    // Tax opens a window for the other Governor only
+    SearchState s(g);
+    CHECK(s.play({Decision::Act, {ActionType::Tax, GameState::kNoSeat}}));
+    REQUIRE(s.inWindow());
+    CHECK(s.toMove() == b);
+    Decision d[SearchState::kMaxDecisions];
+    CHECK(s.decisions(d) == 2);
+
+    SearchState passed = s;
+    CHECK(passed.play({Decision::Pass, {}}));
+    CHECK_FALSE(passed.inWindow());
+    CHECK(passed.game.coins[a] == 3);
+    CHECK(passed.toMove() == b);
+
+    CHECK(s.play({Decision::Block, {}}));
+    CHECK_FALSE(s.inWindow());
+    CHECK(s.game.coins[a] == 0);
+    CHECK(s.toMove() == b);
+
+    // The General may block a Coup on itself by paying 5
+    s.game.coins[b] = 7;
+    CHECK(s.play({Decision::Act, {ActionType::Coup, gen}}));
+    CHECK(s.toMove() == gen);
+    CHECK(s.play({Decision::Block, {}}));
+    CHECK(s.game.isAlive(gen));
+    CHECK(s.game.coins[gen] == 0);
+    CHECK(s.toMove() == gen);
+
+    // Gather never opens a window
+    CHECK(s.play({Decision::Act, {ActionType::Gather, GameState::kNoSeat}}));
+    CHECK_FALSE(s.inWindow());
+    CHECK(s.toMove() == a);
+}
+
+//
+// Test that the search finds an immediately winning Coup and respects budgets.
+//
+TEST_CASE("Mcts: winning move and budgets") {
+    GameState g;
+    int a = g.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 7);
+    int b = g.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 9);
+
+    MctsConfig config;
+    config.iterations = 500;
+    Mcts mcts(config);
+    Decision d = mcts.search(SearchState(g));
+    CHECK(d.kind == Decision::Act);
+    CHECK(d.action.type == ActionType::Coup);
+    CHECK(d.action.target == b);
+    CHECK(mcts.iterations() == 500);
+
+    // Root children are one contiguous run in the arena
+    const Mcts::Node& root = mcts.nodes()[0];
+    CHECK(root.childCount == 2);   // Gather, Coup
+    CHECK(mcts.nodes()[root.firstChild].mover == a);
+
+    config.iterations = 0;
+    config.timeLimitMs = 5;
+    Mcts timed(config);
+    timed.search(SearchState(g));
+    CHECK(timed.iterations() > 0);
+}
@@ -0,0 +1,110 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../include/ObservationLog.hpp"
+#include "../include/Game.hpp"
+#include "../include/Player.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Spy.hpp"
+
+namespace {
+constexpr std::uint8_t bit(RoleId r) { return static_cast<std::uint8_t>(1u << static_cast<int>(r)); }
+}
+
+//
+// Test beliefs: public actions narrow roles and move estimates; reveals are private.
+//
+TEST_CASE("ObservationLog: beliefs from public actions and reveals") {
+    ObservationLog log;
+    log.recordJoin(0, 0);
+    log.recordJoin(1, 4);
+    log.recordJoin(2, 0);
+
+    log.recordAction(0, {ActionType::Tax, GameState::kNoSeat});
+    ObservationLog::Belief b = log.belief(1, 0);
+    CHECK(b.roleMask == bit(RoleId::Governor));   // only the Governor taxes
+    CHECK(b.coins == 3);
+    CHECK(b.slack == 0);
+
+    // Unknown role: a Merchant's start-of-turn bonus and a Baron's
+    // sanction compensation are unseen, so each widens the estimate
+    log.recordAction(1, {ActionType::Gather, GameState::kNoSeat});
+    log.recordAction(2, {ActionType::Gather, GameState::kNoSeat});
+    log.recordAction(0, {ActionType::Sanction, 1});
+    b = log.belief(2, 1);
+    CHECK(b.roleMask == ObservationLog::kAnyRole);
+    CHECK(b.slack == 2);
+    CHECK(b.coins - b.slack <= 4);                // e.g. a Spy: 4 + 1 - 1
+    CHECK(b.coins + b.slack >= 5);                // a Merchant or a Baron: 5
+
+    // Only the Spy learns the exact count
+    log.recordReveal(2, 1, 5);
+    CHECK(log.belief(2, 1).slack == 0);
+    CHECK(log.belief(2, 1).coins == 5);
+    CHECK(log.belief(0, 1).slack == 2);
+
+    // A Coup block marks the General and costs it 5
+    log.recordBlock(1, ActionType::Coup, 2);
+    CHECK(log.belief(2, 1).roleMask == bit(RoleId::General));
+    CHECK(log.belief(2, 1).coins == 0);
+}
+
+//
+// Test that Game feeds joins, actions and Spy reveals into an attached log.
+//
+TEST_CASE("ObservationLog: fed by Game, Player and Spy") {
+    Game game;
+    ObservationLog log;
+    game.setObservationLog(&log);
+    Player gov("Gov", std::make_unique<Governor>(), &game);
+    Player spy("Spy", std::make_unique<Spy>(), &game);
+    game.addPlayer(&gov);
+    game.addPlayer(&spy);
+
+    gov.tax();
+    CHECK_THROWS(gov.tax());                      // rejected actions are not logged
+    spy.specialAction(spy, gov);
+
+    const std::vector<ObservationLog::Event>& ev = log.events();
+    REQUIRE(ev.size() == 4);
+    CHECK(ev[0].kind == ObservationLog::Event::Join);
+    CHECK(ev[2].kind == ObservationLog::Event::Act);
+    CHECK(ev[2].type == ActionType::Tax);
+    CHECK(ev[3].kind == ObservationLog::Event::Reveal);
+    CHECK(ev[3].coins == 3);
+    CHECK(log.belief(spy.id(), gov.id()).coins == 3);
+}
+
+//
+// Test that a block takes back what the blocked action was credited with.
+//
+TEST_CASE("ObservationLog: a blocked Tax is not counted") {
+    ObservationLog log;
+    log.recordJoin(0, 5);
+    log.recordJoin(1, 0);
+
+    log.recordAction(0, {ActionType::Tax, GameState::kNoSeat});
+    CHECK(log.belief(1, 0).coins == 8);
+
+    log.recordBlock(1, ActionType::Tax, 0);
+    ObservationLog::Belief b = log.belief(1, 0);
+    CHECK(b.roleMask == bit(RoleId::Governor));   // the Tax was still declared
+    CHECK(b.coins == 5);
+    CHECK(b.slack == 1);                          // the unseen start-of-turn bonus stays
+    CHECK(log.belief(0, 1).roleMask == bit(RoleId::Governor));
+
+    // A second block finds no Tax left to take back
+    log.recordBlock(1, ActionType::Tax, 0);
+    CHECK(log.belief(1, 0).coins == 5);
+
+    // A blocked Sanction keeps its cost, fines the offender 1 more and
+    // leaves the target as it was
+    log.recordAction(1, {ActionType::Gather, GameState::kNoSeat});
+    log.recordAction(1, {ActionType::Gather, GameState::kNoSeat});
+    log.recordAction(1, {ActionType::Gather, GameState::kNoSeat});
+    log.recordAction(0, {ActionType::Sanction, 1});
+    log.recordBlock(1, ActionType::Sanction, 1);
+    CHECK(log.belief(1, 0).coins == 1);           // 5 - 3, then - 1
+    CHECK(log.belief(0, 1).coins == 3);
+    CHECK(log.belief(0, 1).slack == 0);
+}
@@ -0,0 +1,61 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../ai/ParallelMcts.hpp"
+
+namespace {
+// Two Spies: the first can win at once with a Coup the other cannot block.
+GameState coupPosition() {
+    GameState g;
+    g.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 7);
+    g.addSeat(RoleId::Spy, GameState::abilitiesOf(RoleId::Spy), 9);
+    return g;
+}
+}
+
+//
+// Test the shared tree: budget split across threads, virtual losses undone.
+//
+TEST_CASE("ParallelMcts: tree parallel") {
+    MctsConfig config;
+    config.iterations = 2000;
+    ParallelMcts::Options options;
+    options.threads = 4;
+    options.mode = ParallelMcts::Mode::Tree;
+    ParallelMcts search(config, options);
+
+    Decision d = search.search(SearchState(coupPosition()));
+    CHECK(d.action.type == ActionType::Coup);
+    CHECK(d.action.target == 1);
+    CHECK(search.playouts() == 2000);
+    CHECK(search.nodeCount() > 1);
+
+    // A tiny pool stops expansion but not the search
+    options.maxNodes = 1;
+    ParallelMcts tiny(config, options);
+    tiny.search(SearchState(coupPosition()));
+    CHECK(tiny.playouts() == 2000);
+    CHECK(tiny.nodeCount() == 1);
+}
+
+//
+// Test per-thread trees merged at the root.
+//
+TEST_CASE("ParallelMcts: root parallel") {
+    MctsConfig config;
+    config.iterations = 1001;
+    ParallelMcts::Options options;
+    options.threads = 4;
+    options.mode = ParallelMcts::Mode::Root;
+    ParallelMcts search(config, options);
+
+    Decision d = search.search(SearchState(coupPosition()));
+    CHECK(d.action.type == ActionType::Coup);
+    CHECK(search.playouts() == 1001);
+
+    config.iterations = 0;
+    config.timeLimitMs = 5;
+    ParallelMcts timed(config, options);
+    timed.search(SearchState(coupPosition()));
+    CHECK(timed.playouts() > 0);
+}
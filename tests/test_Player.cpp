@@ -342,3 +342,27 @@ TEST_CASE("Player: any action out of turn throws NotYourTurn") {
     // Now Bob’s turn; Alice tries to tax → out of turn
     CHECK_THROWS_AS(alice.tax(), NotYourTurn);
 }
+
+//
+// Test the non-throwing action family: result codes, no exceptions.
+//
+TEST_CASE("Player: try-actions return result codes") {
+    Game game;
+    Player alice("Alice", std::make_unique<Governor>(), &game);
+    Player bob("Bob", std::make_unique<Spy>(), &game);
+    game.addPlayer(&alice);
+    game.addPlayer(&bob);
+
+    CHECK(bob.tryGather() == ActionResult::NotYourTurn);
+    CHECK(alice.tryBribe() == ActionResult::NotAllowed);
+    CHECK(alice.tryCoup(bob) == ActionResult::OutOfCoins);
+    CHECK(alice.tryTax() == ActionResult::Ok);
+    CHECK(alice.coins() == 3);
+    CHECK(game.turn() == "Bob");
+
+    bob.addCoins(7);
+    CHECK(bob.tryCoup(bob) == ActionResult::SelfTarget);
+    CHECK(bob.coins() == 7);                 // rejected actions change nothing
+    CHECK(bob.tryCoup(alice) == ActionResult::Ok);
+    CHECK(game.winner() == "Bob");
+}
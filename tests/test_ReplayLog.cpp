@@ -0,0 +1,154 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "../include/Game.hpp"
+#include "../include/Player.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Spy.hpp"
+#include "../include/ReplayLog.hpp"
+
+namespace {
+
+const char* kPath = "test_replay.bin";
+
+std::vector<unsigned char> readAll(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<unsigned char>(std::istreambuf_iterator<char>(in), {});
+}
+
+// Minimal LEB128 decoder over the file contents.
+struct Cursor {
+    const std::vector<unsigned char>& bytes;
+    std::size_t pos;
+
+    std::uint64_t next() {
+        std::uint64_t v = 0;
+        int shift = 0;
+        while (bytes[pos] & 0x80) {
+            v |= static_cast<std::uint64_t>(bytes[pos++] & 0x7f) << shift;
+            shift += 7;
+        }
+        return v | (static_cast<std::uint64_t>(bytes[pos++]) << shift);
+    }
+};
+
+} // namespace
+
+//
+// Test the journal of a short match: header, input events in call order,
+// the derived events they cause, and the result.
+//
+TEST_CASE("ReplayLog: events of a short match") {
+    std::remove(kPath);
+    int govCoins = 0;
+    int spyCoins = 0;
+    {
+        ReplayWriter writer(kPath);
+        Game game;
+        game.setReplayWriter(&writer);
+        CHECK(game.replayWriter() == &writer);
+        Player gov("G", std::make_unique<Governor>(), &game);
+        Player spy("S", std::make_unique<Spy>(), &game);
+        writer.beginMatch(7);
+        game.addPlayer(&gov);
+        game.addPlayer(&spy);
+
+        gov.tax();                      // Act, Resolve, Turn(1)
+        spy.addCoins(7);                // Coins
+        game.registerCoup(&spy, &gov);  // Register
+        game.nextTurn();                // NextTurn, Resolve, Removed(0), Turn
+        writer.endMatch(game.state());
+        govCoins = gov.coins();
+        spyCoins = spy.coins();
+    }
+
+    const std::vector<unsigned char> bytes = readAll(kPath);
+    REQUIRE(bytes.size() > sizeof(Replay::kMagic));
+    CHECK(std::memcmp(bytes.data(), Replay::kMagic, sizeof(Replay::kMagic)) == 0);
+
+    Cursor c{bytes, sizeof(Replay::kMagic)};
+    CHECK(c.next() == Replay::Begin);
+    CHECK(c.next() == 7);
+
+    CHECK(c.next() == Replay::Join);
+    CHECK(c.next() == 0);
+    CHECK(c.next() == static_cast<std::uint64_t>(RoleId::Governor));
+    CHECK(c.next() == 0);
+    CHECK(c.next() == Replay::Join);
+    CHECK(c.next() == 1);
+    CHECK(c.next() == static_cast<std::uint64_t>(RoleId::Spy));
+    CHECK(c.next() == 0);
+
+    CHECK(c.next() == Replay::Act);
+    CHECK(c.next() == 0);
+    CHECK(c.next() == static_cast<std::uint64_t>(ActionType::Tax));
+    CHECK(c.next() == 0);               // no target
+    CHECK(c.next() == Replay::Resolve);
+    CHECK(c.next() == static_cast<std::uint64_t>(ActionType::Tax));
+    CHECK(c.next() == 1);
+    CHECK(c.next() == 0);
+    CHECK(c.next() == 0);
+    CHECK(c.next() == Replay::Turn);
+    CHECK(c.next() == 1);
+
+    CHECK(c.next() == Replay::Coins);
+    CHECK(c.next() == 1);
+    CHECK(c.next() == 14);              // zigzag(7)
+
+    CHECK(c.next() == Replay::Register);
+    CHECK(c.next() == static_cast<std::uint64_t>(ActionType::Coup));
+    CHECK(c.next() == 2);
+    CHECK(c.next() == 1);
+
+    CHECK(c.next() == Replay::NextTurn);
+    CHECK(c.next() == Replay::Resolve);
+    CHECK(c.next() == static_cast<std::uint64_t>(ActionType::Coup));
+    CHECK(c.next() == 2);
+    CHECK(c.next() == 1);
+    CHECK(c.next() == 0);               // not blocked
+    CHECK(c.next() == Replay::Removed);
+    CHECK(c.next() == 0);
+
+    // The result: the Spy wins.
+    while (c.pos < bytes.size() && bytes[c.pos] != Replay::End) c.next();
+    CHECK(c.next() == Replay::End);
+    CHECK(c.next() == 2);               // winner seat 1
+    c.next();                           // pool
+    CHECK(c.next() == 2);               // seats
+    CHECK(c.next() == static_cast<std::uint64_t>(govCoins));
+    CHECK(c.next() == static_cast<std::uint64_t>(spyCoins));
+    CHECK(c.pos == bytes.size());
+    std::remove(kPath);
+}
+
+//
+// Test appending: a second writer on the same file adds matches without a
+// second header, and a detached game records nothing.
+//
+TEST_CASE("ReplayLog: append and detach") {
+    std::remove(kPath);
+    {
+        ReplayWriter writer(kPath);
+        writer.beginMatch(1);
+        CHECK(writer.bytesWritten() == sizeof(Replay::kMagic) + 2);
+    }
+    {
+        ReplayWriter writer(kPath);
+        Game game;
+        Player gov("G", std::make_unique<Governor>(), &game);
+        game.addPlayer(&gov);
+        game.setReplayWriter(&writer);
+        game.setReplayWriter(nullptr);
+        game.nextTurn();
+        writer.beginMatch(2);
+        CHECK(writer.bytesWritten() == 2);
+    }
+    const std::vector<unsigned char> bytes = readAll(kPath);
+    CHECK(bytes.size() == sizeof(Replay::kMagic) + 4);
+    std::remove(kPath);
+}
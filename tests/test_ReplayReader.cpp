@@ -0,0 +1,185 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include "../include/Game.hpp"
+#include "../include/Player.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Spy.hpp"
+#include "../include/General.hpp"
+#include "../include/ReplayLog.hpp"
+#include "../include/ReplayReader.hpp"
+
+namespace {
+
+const char* kPath = "test_replay_reader.bin";
+
+//
+// One match using every kind of input event. If tamper is set, the
+// recorded result gives seat 1 a coin it never had.
+//
+void recordMatch(ReplayWriter& writer, std::uint64_t id, bool tamper) {
+    Game game;
+    Player gov("G", std::make_unique<Governor>(), &game);
+    Player spy("S", std::make_unique<Spy>(), &game);
+    Player gen("N", std::make_unique<General>(), &game);
+    gen.addCoins(2);                     // before joining: part of Join
+    game.setReplayWriter(&writer);
+    writer.beginMatch(id);
+    game.addPlayer(&gov);
+    game.addPlayer(&spy);
+    game.addPlayer(&gen);
+
+    gov.tax();                           // Act
+    spy.gather();
+    gen.gather();
+    game.apply({ActionType::Tax, GameState::kNoSeat});   // Apply
+    game.undo();                                         // Undo
+    game.apply({ActionType::Gather, GameState::kNoSeat});
+    spy.addCoins(9);                     // Coins
+    game.takeFromPool(1);                // Pool
+    game.registerTax(&gov);              // Register
+    game.blockTax(&spy, &gov);           // Block
+    game.registerCoup(&spy, &gen);
+    game.nextTurn();                     // NextTurn, Resolve, Removed, Turn
+    spy.removeCoins(2);
+    game.removePlayer(&gov);             // Remove
+
+    GameState result = game.state();
+    if (tamper) result.coins[1] += 1;
+    writer.endMatch(result);
+}
+
+} // namespace
+
+//
+// Test reading: the header is checked and events decode in order with
+// their fields.
+//
+TEST_CASE("ReplayReader: decodes what the writer wrote") {
+    std::remove(kPath);
+    {
+        ReplayWriter writer(kPath);
+        recordMatch(writer, 42, false);
+    }
+    ReplayReader reader(kPath);
+    Replay::Event e;
+    REQUIRE(reader.next(e));
+    CHECK(e.kind == Replay::Begin);
+    CHECK(e.id == 42);
+    REQUIRE(reader.next(e));
+    CHECK(e.kind == Replay::Join);
+    CHECK(e.seat == 0);
+    CHECK(e.role == RoleId::Governor);
+    reader.next(e);
+    reader.next(e);
+    CHECK(e.kind == Replay::Join);
+    CHECK(e.role == RoleId::General);
+    CHECK(e.value == 2);
+    REQUIRE(reader.next(e));
+    CHECK(e.kind == Replay::Act);
+    CHECK(e.type == ActionType::Tax);
+    CHECK(e.target == GameState::kNoSeat);
+
+    int kinds[Replay::End + 1] = {};
+    long count = 5;
+    while (reader.next(e)) {
+        ++kinds[e.kind];
+        ++count;
+        if (e.kind == Replay::Coins && e.value < 0) CHECK(e.value == -2);
+    }
+    CHECK(kinds[Replay::Apply] == 2);
+    CHECK(kinds[Replay::Undo] == 1);
+    CHECK(kinds[Replay::Coins] == 2);
+    CHECK(kinds[Replay::Pool] == 1);
+    CHECK(kinds[Replay::Register] == 2);
+    CHECK(kinds[Replay::Block] == 1);
+    CHECK(kinds[Replay::Remove] == 1);
+    CHECK(kinds[Replay::End] == 1);
+    CHECK(e.kind == Replay::End);
+    CHECK(e.seatCount == 3);
+    CHECK(reader.offset() == reader.size());
+
+    reader.rewind();
+    REQUIRE(reader.next(e));
+    CHECK(e.kind == Replay::Begin);
+
+    Resimulator sim;
+    Replay::Verdict verdict;
+    reader.rewind();
+    REQUIRE(sim.run(reader, verdict));
+    CHECK(verdict.ok);
+    CHECK(verdict.events == static_cast<std::uint64_t>(count));
+    std::remove(kPath);
+}
+
+//
+// Test re-simulation over several matches: faithful ones pass, a tampered
+// result is caught, and the reader stays aligned on the next match.
+//
+TEST_CASE("ReplayReader: re-simulation checks the recorded result") {
+    std::remove(kPath);
+    {
+        ReplayWriter writer(kPath);
+        recordMatch(writer, 1, false);
+        recordMatch(writer, 2, true);
+        recordMatch(writer, 3, false);
+    }
+    ReplayReader reader(kPath);
+    Resimulator sim;
+    Replay::Verdict verdict;
+
+    REQUIRE(sim.run(reader, verdict));
+    CHECK(verdict.match == 1);
+    CHECK(verdict.ok);
+    CHECK(verdict.reason.empty());
+
+    REQUIRE(sim.run(reader, verdict));
+    CHECK(verdict.match == 2);
+    CHECK_FALSE(verdict.ok);
+    CHECK(verdict.reason.find("coins of seat 1") != std::string::npos);
+
+    REQUIRE(sim.run(reader, verdict));
+    CHECK(verdict.match == 3);
+    CHECK(verdict.ok);
+
+    CHECK_FALSE(sim.run(reader, verdict));
+    std::remove(kPath);
+}
+
+//
+// Test rejected input: an action the rules refuse is reported with the
+// event that failed; bad files are refused on open.
+//
+TEST_CASE("ReplayReader: divergent input and bad files") {
+    std::remove(kPath);
+    {
+        ReplayWriter writer(kPath);
+        Game game;
+        Player gov("G", std::make_unique<Governor>(), &game);
+        Player spy("S", std::make_unique<Spy>(), &game);
+        game.addPlayer(&gov);
+        game.addPlayer(&spy);
+        writer.beginMatch(9);
+        writer.join(0, RoleId::Governor, 0);
+        writer.join(1, RoleId::Spy, 0);
+        writer.act(1, {ActionType::Gather, GameState::kNoSeat}, false);  // not seat 1's turn
+        writer.endMatch(game.state());
+    }
+    {
+        ReplayReader reader(kPath);
+        Resimulator sim;
+        Replay::Verdict verdict;
+        REQUIRE(sim.run(reader, verdict));
+        CHECK_FALSE(verdict.ok);
+        CHECK(verdict.reason.find("event 3 (Act)") == 0);
+    }
+
+    std::FILE* f = std::fopen(kPath, "wb");
+    std::fputs("not a replay", f);
+    std::fclose(f);
+    CHECK_THROWS_AS(ReplayReader{kPath}, std::runtime_error);
+    std::remove(kPath);
+    CHECK_THROWS_AS(ReplayReader{kPath}, std::runtime_error);
+}
@@ -0,0 +1,58 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <cstring>
+#include <type_traits>
+#include "../include/RoleRegistry.hpp"
+#include "../include/RoleRules.hpp"
+
+static_assert(BuiltinRoles::size == static_cast<std::size_t>(RoleId::Custom),
+              "BuiltinRoles must list every built-in RoleId");
+static_assert(std::is_same<RoleAt<0>, Governor>::value && std::is_same<RoleAt<5>, Merchant>::value,
+              "BuiltinRoles is in RoleId order");
+static_assert(std::is_final<Spy>::value, "built-in roles are final so calls devirtualize");
+
+//
+// Test the registry against the classes and the rules table: each RoleId
+// reaches the class with that id, whose abilities match kRoleRules.
+//
+TEST_CASE("RoleRegistry: dispatch matches the role classes and rules") {
+    for (int i = 0; i < static_cast<int>(RoleId::Custom); ++i) {
+        const RoleId id = static_cast<RoleId>(i);
+        CAPTURE(i);
+        CHECK(visitRole(id, [](const auto& r) { return r.id(); }) == id);
+        CHECK(std::strcmp(visitRole(id, [](const auto& r) { return r.name(); }).c_str(),
+                          roleIdName(id)) == 0);
+
+        const std::uint8_t bits = visitRole(id, [](const auto& r) { return abilityBits(r); });
+        CHECK(bits == GameState::abilitiesOf(id));
+        CHECK(((bits & GameState::CanTax) != 0) == rulesOf(id).canTax);
+        CHECK(((bits & GameState::CanArrest) != 0) == rulesOf(id).canArrest);
+
+        Role* shared = Role::flyweight(id);
+        CHECK(shared == visitRole(id, [](Role& r) { return &r; }));
+
+        RoleVariant v = makeRoleVariant(id);
+        CHECK(v.index() == static_cast<std::size_t>(i));
+        CHECK(std::visit([](const auto& r) { return r.id(); }, v) == id);
+    }
+    CHECK(Role::flyweight(RoleId::Custom) == nullptr);
+}
+
+//
+// Test the Player side: hooks of built-in roles run through the registry.
+//
+TEST_CASE("RoleRegistry: Player hooks and abilities") {
+    Game game;
+    Player mer("M", RoleId::Merchant, &game);
+    Player gov("G", std::make_unique<Governor>(), &game);
+    game.addPlayer(&mer);
+    game.addPlayer(&gov);
+
+    mer.addCoins(3);
+    mer.onStartTurn();
+    CHECK(mer.coins() == 4);   // Merchant bonus at ≥3
+    gov.onStartTurn();
+    CHECK(gov.coins() == 0);
+    CHECK(game.state().abilities[gov.id()] == GameState::abilitiesOf(RoleId::Governor));
+}
@@ -0,0 +1,112 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../include/MatchArena.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Spy.hpp"
+#include "../include/Baron.hpp"
+#include "../include/General.hpp"
+#include "../include/Judge.hpp"
+#include "../include/Merchant.hpp"
+
+namespace {
+
+// A six-player match with coins moved, a player couped and pending
+// actions (one of them blocked) waiting for the next turn.
+void playSome(MatchArena& arena) {
+    Player& gov = arena.addPlayer<Governor>("Gov");
+    Player& spy = arena.addPlayer<Spy>("Spy");
+    arena.addPlayer<Baron>("Baron");
+    Player& gen = arena.addPlayer<General>("Gen");
+    arena.addPlayer<Judge>("Judge");
+    Player& mer = arena.addPlayer<Merchant>("Mer");
+    Game& g = arena.game();
+
+    spy.addCoins(7);
+    g.registerCoup(&spy, &mer);
+    g.nextTurn();                      // Mer is out
+    gov.addCoins(2);
+    g.registerTax(&gov);
+    g.registerArrest(&gen, &spy);
+    g.blockArrest(&spy, &spy);
+}
+
+// The same number of seats with other names and roles.
+void seatStrangers(MatchArena& arena) {
+    for (const char* name : {"a", "b", "c", "d", "e", "f"}) arena.addPlayer<Judge>(name);
+}
+
+} // namespace
+
+//
+// Test a round trip: the restored game matches the original position,
+// names and roles, and plays on identically.
+//
+TEST_CASE("Snapshot: restore reproduces the match") {
+    MatchArena from;
+    playSome(from);
+    Game& a = from.game();
+    const std::vector<std::uint8_t> blob = a.snapshot();
+    CHECK(blob[0] == Game::kSnapshotVersion);
+    CHECK(blob.size() < 100);
+
+    MatchArena to;
+    seatStrangers(to);
+    Game& b = to.game();
+    Player* const before = b.playerAt(1);
+    b.restore(blob);
+
+    CHECK(b.playerAt(1) == before);    // same Player object, rebound
+    CHECK(b.state().hash == a.state().hash);
+    CHECK(b.state().computeHash() == b.state().hash);
+    CHECK(b.turn() == a.turn());
+    CHECK(b.players() == a.players());
+    CHECK(b.idOf("Gen") == 3);
+    CHECK(b.idOf("a") == GameState::kNoSeat);
+    CHECK(b.playerAt(0)->roleName() == "Governor");
+    CHECK(b.playerAt(5)->roleName() == "Merchant");
+    CHECK(b.playerAt(1)->coins() == a.playerAt(1)->coins());
+    CHECK(b.state().findPending(ActionType::Tax, 0) == a.state().findPending(ActionType::Tax, 0));
+    CHECK(b.state().findPending(ActionType::Arrest, 1) == -1);
+    CHECK(b.snapshot() == blob);
+
+    a.nextTurn();
+    b.nextTurn();
+    CHECK(b.state().hash == a.state().hash);
+    CHECK(b.playerAt(0)->coins() == a.playerAt(0)->coins());
+    CHECK(b.turn() == a.turn());
+}
+
+//
+// Test rejection: a blob that does not fit the game is refused and the
+// game is left untouched.
+//
+TEST_CASE("Snapshot: bad blobs change nothing") {
+    MatchArena from;
+    playSome(from);
+    const std::vector<std::uint8_t> blob = from.game().snapshot();
+
+    MatchArena to;
+    seatStrangers(to);
+    Game& g = to.game();
+    const std::uint64_t hash = g.state().hash;
+
+    std::vector<std::uint8_t> bad = blob;
+    bad[0] = 99;
+    CHECK_THROWS_AS(g.restore(bad), IllegalAction);
+    CHECK_THROWS_AS(g.restore(blob.data(), blob.size() - 1), IllegalAction);
+    bad = blob;
+    bad.push_back(0);
+    CHECK_THROWS_AS(g.restore(bad), IllegalAction);
+    bad = blob;
+    bad[3] = 9;                        // current index past the active players
+    CHECK_THROWS_AS(g.restore(bad), IllegalAction);
+
+    MatchArena small;
+    small.addPlayer<Governor>("x");
+    CHECK_THROWS_AS(small.game().restore(blob), IllegalAction);
+
+    CHECK(g.state().hash == hash);
+    CHECK(g.turn() == "a");
+    CHECK(g.playerAt(0)->roleName() == "Judge");
+}
@@ -0,0 +1,124 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <cstdlib>
+#include <new>
+#include "../include/Game.hpp"
+#include "../include/Player.hpp"
+#include "../include/Governor.hpp"
+#include "../include/Spy.hpp"
+#include "../include/Baron.hpp"
+#include "../include/General.hpp"
+#include "../include/Judge.hpp"
+#include "../include/Merchant.hpp"
+
+//
+// Every allocation in this program is counted while gCounting is set.
+//
+namespace {
+long gAllocs = 0;
+bool gCounting = false;
+}
+
+void* operator new(std::size_t n) {
+    if (gCounting) ++gAllocs;
+    void* p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+//
+// Test the steady state: once the table is seated, 10,000 turns of taxes,
+// gathers, coups blocked by the General, nextTurn and processPending must
+// not allocate. Names are longer than any small-string buffer, so a copied
+// name would show up as an allocation.
+//
+TEST_CASE("Steady state: a 10,000-turn match does not allocate") {
+    Game game;
+    Player gov("Governor of the Northern Provinces", std::make_unique<Governor>(), &game);
+    Player spy("Spy in the Service of the Crown", std::make_unique<Spy>(), &game);
+    Player baron("Baron of the Eastern Marches", std::make_unique<Baron>(), &game);
+    Player general("General of the Standing Army", std::make_unique<General>(), &game);
+    Player judge("Judge of the High Court of Appeal", std::make_unique<Judge>(), &game);
+    Player merchant("Merchant of the Western Harbour", std::make_unique<Merchant>(), &game);
+    Player* const table[] = {&gov, &spy, &baron, &general, &judge, &merchant};
+    for (Player* p : table) game.addPlayer(p);
+
+    long turns = 0;
+    long blocks = 0;
+    bool named = true;
+    gAllocs = 0;
+    gCounting = true;
+    for (; turns < 10000; ++turns) {
+        Player* p = game.playerAt(game.state().currentSeat());
+        named = named && game.turn() == p->name();
+
+        // At 7 or more coins a player coups the Judge (or, being the Judge,
+        // the Merchant), paying 7 as Player::coup does, whenever the General
+        // can afford to block it (paying 5)
+        Player* victim = p == &judge ? &merchant : &judge;
+        if (p != &general && p->coins() >= 7 && general.coins() >= 5) {
+            p->removeCoins(7);
+            game.registerCoup(p, victim);
+            general.blockCoup(*victim);
+            game.nextTurn();
+            ++blocks;
+        } else if (p != &gov) {
+            p->gather();
+        } else if (turns % 2 == 0) {
+            gov.tax();
+        } else {
+            game.registerTax(&gov);
+            game.nextTurn();
+        }
+    }
+    gCounting = false;
+
+    CHECK(turns == 10000);
+    CHECK(blocks > 0);
+    CHECK(named);
+    CHECK(game.state().activeCount == 6);
+    CHECK(gAllocs == 0);
+}
+
+//
+// Test role flyweights: copying a Player with a built-in role shares the
+// role instead of cloning it, while a custom role is still deep-copied.
+//
+TEST_CASE("Steady state: copying players does not clone built-in roles") {
+    struct Custom : Role {
+        std::unique_ptr<Role> clone() const override { return std::make_unique<Custom>(*this); }
+        void specialAction(Player&, Player&) override {}
+        std::string name() const override { return "Custom"; }
+    };
+
+    Game game;
+    Player gov("G", std::make_unique<Governor>(), &game);
+    Player spy("S", RoleId::Spy, &game);
+    Player odd("C", std::make_unique<Custom>(), &game);
+    game.addPlayer(&gov);
+    game.addPlayer(&spy);
+    game.addPlayer(&odd);
+
+    gAllocs = 0;
+    gCounting = true;
+    Player govCopy(gov);
+    Player spyCopy(spy);
+    govCopy = spyCopy;
+    gCounting = false;
+    CHECK(gAllocs == 0);
+    CHECK(govCopy.roleName() == "Spy");
+    CHECK(gov.roleName() == "Governor");
+
+    gAllocs = 0;
+    gCounting = true;
+    Player oddCopy(odd);
+    gCounting = false;
+    CHECK(gAllocs == 1);
+    CHECK(oddCopy.roleName() == "Custom");
+
+    CHECK_THROWS_AS(Player("X", RoleId::Custom, &game), IllegalAction);
+}
@@ -0,0 +1,108 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../server/TimerWheel.hpp"
+
+//
+// Test timers firing on their tick, in order, and cancel leaving no trace.
+//
+TEST_CASE("TimerWheel: fire and cancel") {
+    TimerWheel wheel(1000);
+    std::vector<std::uint64_t> fired;
+    auto record = [&](std::uint64_t cookie) { fired.push_back(cookie); };
+
+    wheel.schedule(5, 5);
+    wheel.schedule(1, 1);
+    TimerWheel::Handle three = wheel.schedule(3, 3);
+    wheel.schedule(0, 0);                       // raised to one tick
+    CHECK(wheel.size() == 4);
+    CHECK(wheel.nextDeadline() == 1001);
+
+    CHECK(wheel.cancel(three));
+    CHECK_FALSE(wheel.cancel(three));
+    CHECK_FALSE(wheel.cancel(TimerWheel::kNoTimer));
+
+    CHECK(wheel.advance(1004, record) == 2);
+    CHECK(fired.size() == 2);                   // both due at 1001
+    CHECK(fired[0] + fired[1] == 1);
+    CHECK(wheel.nextDeadline() == 1005);
+    CHECK(wheel.advance(1005, record) == 1);
+    CHECK(fired.back() == 5);
+    CHECK(wheel.size() == 0);
+    CHECK(wheel.nextDeadline() == ~std::uint64_t(0));
+
+    // The freed nodes are reused; handles to their old timers stay stale.
+    TimerWheel::Handle again = wheel.schedule(2, 7);
+    CHECK_FALSE(wheel.cancel(three));
+    CHECK(wheel.cancel(again));
+}
+
+//
+// Test delays across every level and beyond: each fires exactly on its
+// tick, however the clock is advanced.
+//
+TEST_CASE("TimerWheel: cascades keep exact deadlines") {
+    const std::uint64_t delays[] = {63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000,
+                                    TimerWheel::kMaxDelay, TimerWheel::kMaxDelay + 1000};
+    for (std::uint64_t step : {std::uint64_t(1), std::uint64_t(7), std::uint64_t(1000)}) {
+        TimerWheel wheel(12345);
+        for (std::uint64_t d : delays) wheel.schedule(d, d);
+        bool exact = true;
+        std::size_t count = 0;
+        while (wheel.size() > 0) {
+            wheel.advance(wheel.now() + step, [&](std::uint64_t d) {
+                std::uint64_t due = 12345 + (d > TimerWheel::kMaxDelay ? TimerWheel::kMaxDelay : d);
+                exact = exact && (step == 1 ? wheel.now() == due : wheel.now() >= due && wheel.now() < due + step);
+                ++count;
+            });
+        }
+        CHECK(exact);
+        CHECK(count == sizeof(delays) / sizeof(delays[0]));
+    }
+}
+
+//
+// Test 100k open windows with random lengths, half of them cancelled,
+// a few rescheduled from inside the callback.
+//
+TEST_CASE("TimerWheel: 100k windows") {
+    constexpr std::size_t kWindows = 100000;
+    TimerWheel wheel(0, kWindows);
+    std::mt19937_64 rng(42);
+    std::vector<TimerWheel::Handle> handles(kWindows);
+    std::vector<std::uint64_t> due(kWindows);
+    for (std::size_t i = 0; i < kWindows; ++i) {
+        std::uint64_t delay = 1 + rng() % 5000;
+        due[i] = delay;
+        handles[i] = wheel.schedule(delay, i);
+    }
+    CHECK(wheel.size() == kWindows);
+    for (std::size_t i = 0; i < kWindows; i += 2) CHECK(wheel.cancel(handles[i]));
+    CHECK(wheel.size() == kWindows / 2);
+
+    std::size_t fired = 0;
+    std::size_t late = 0;
+    std::size_t rescheduled = 0;
+    std::vector<bool> seen(kWindows + 100, false);
+    std::uint64_t last = 0;
+    bool ordered = true;
+    for (std::uint64_t t = 1; wheel.size() > 0; ++t) {
+        wheel.advance(t, [&](std::uint64_t i) {
+            ordered = ordered && t >= last;
+            last = t;
+            if (i < kWindows && (i % 2 == 0 || t != due[i])) ++late;
+            seen[i] = true;
+            ++fired;
+            if (i < kWindows && rescheduled < 100) {
+                wheel.schedule(10, kWindows + rescheduled++);
+            }
+        });
+    }
+    CHECK(late == 0);
+    CHECK(ordered);
+    CHECK(fired == kWindows / 2 + 100);
+    for (std::size_t i = 0; i < 100; ++i) CHECK(seen[kWindows + i]);
+}